@@ -134,4 +134,8 @@ extern "C" {
         return memory::get_allocation_size();
     }
 
+    uint64_t Z3_API Z3_get_thread_alloc_size(void) {
+        return memory::get_thread_allocation_size();
+    }
+
 };
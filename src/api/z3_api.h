@@ -6820,6 +6820,13 @@ extern "C" {
     */
     uint64_t Z3_API Z3_get_estimated_alloc_size(void);
 
+    /**
+    \brief Return the number of bytes allocated minus the number of bytes freed by the calling thread.
+
+    def_API('Z3_get_thread_alloc_size', UINT64, ())
+    */
+    uint64_t Z3_API Z3_get_thread_alloc_size(void);
+
     /*@}*/
 
 #ifdef __cplusplus
@@ -76,6 +76,7 @@ algebraic_numbers::manager & arith_decl_plugin::am() const {
 }
 
 app * arith_decl_plugin::mk_numeral(algebraic_numbers::manager& m, algebraic_numbers::anum const & val, bool is_int) {
+    ast_manager::concurrent_lock lock(*m_manager);
     if (m.is_rational(val)) {
         rational rval;
         m.to_rational(val, rval);
@@ -418,6 +419,8 @@ inline decl_kind arith_decl_plugin::fix_kind(decl_kind k, unsigned arity) {
 #define MAX_SMALL_NUM_TO_CACHE 16
 
 app * arith_decl_plugin::mk_numeral(rational const & val, bool is_int) {
+    // the numeral caches are shared by the threads of a concurrent manager
+    ast_manager::concurrent_lock lock(*m_manager);
     if (is_int && !val.is_int()) {
         m_manager->raise_exception("invalid rational value passed as an integer");
     }
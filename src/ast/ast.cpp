@@ -28,7 +28,12 @@ Revision History:
 #include "ast/ast_smt2_pp.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/ast_translation.h"
+#include "ast/expr_lru_cache.h"
 #include "util/z3_version.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AST_SSE2_COMPARE
+#endif
 
 
 // -----------------------------------
@@ -335,15 +340,6 @@ func_decl::func_decl(symbol const & name, unsigned arity, sort * const * domain,
 //
 // -----------------------------------
 
-static app_flags mk_const_flags() {
-    app_flags r;
-    r.m_depth           = 1;
-    r.m_ground          = true;
-    r.m_has_quantifiers = false;
-    r.m_has_labels      = false;
-    return r;
-}
-
 static app_flags mk_default_app_flags() {
     app_flags r;
     r.m_depth           = 1;
@@ -353,12 +349,11 @@ static app_flags mk_default_app_flags() {
     return r;
 }
 
-app_flags app::g_constant_flags = mk_const_flags();
-
 app::app(func_decl * decl, unsigned num_args, expr * const * args):
     expr(AST_APP),
     m_decl(decl),
-    m_num_args(num_args) {
+    m_num_args(num_args),
+    m_flags(mk_default_app_flags()) {
     for (unsigned i = 0; i < num_args; i++)
         m_args[i] = args[i];
 }
@@ -452,6 +447,29 @@ unsigned get_node_size(ast const * n) {
     return 0;
 }
 
+/**
+   \brief compare arrays of pointers, 16 bytes at a time when SSE2 is available.
+*/
+template<typename T>
+static inline bool compare_ptr_arrays(T * const * array1, T * const * array2, unsigned size) {
+#ifdef AST_SSE2_COMPARE
+    const unsigned k = sizeof(__m128i) / sizeof(T *);
+    unsigned i = 0;
+    for (; i + k <= size; i += k) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(array1 + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(array2 + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+            return false;
+    }
+    for (; i < size; i++)
+        if (array1[i] != array2[i])
+            return false;
+    return true;
+#else
+    return compare_arrays(array1, array2, size);
+#endif
+}
+
 bool compare_nodes(ast const * n1, ast const * n2) {
     if (n1->get_kind() != n2->get_kind()) {
         return false;
@@ -476,14 +494,14 @@ bool compare_nodes(ast const * n1, ast const * n2) {
             to_func_decl(n1)->get_name()  == to_func_decl(n2)->get_name() &&
             to_func_decl(n1)->get_arity() == to_func_decl(n2)->get_arity() &&
             to_func_decl(n1)->get_range() == to_func_decl(n2)->get_range() &&
-            compare_arrays(to_func_decl(n1)->get_domain(),
-                           to_func_decl(n2)->get_domain(),
-                           to_func_decl(n1)->get_arity());
+            compare_ptr_arrays(to_func_decl(n1)->get_domain(),
+                               to_func_decl(n2)->get_domain(),
+                               to_func_decl(n1)->get_arity());
     case AST_APP:
         return
             to_app(n1)->get_decl()     == to_app(n2)->get_decl() &&
             to_app(n1)->get_num_args() == to_app(n2)->get_num_args() &&
-            compare_arrays(to_app(n1)->get_args(), to_app(n2)->get_args(), to_app(n1)->get_num_args());
+            compare_ptr_arrays(to_app(n1)->get_args(), to_app(n2)->get_args(), to_app(n1)->get_num_args());
     case AST_VAR:
         return
             to_var(n1)->get_idx()  == to_var(n2)->get_idx() &&
@@ -613,7 +631,7 @@ void ast_table::push_erase(ast * n) {
     while (true) {
         SASSERT(!c->is_free());
         cell * next = c->m_next;
-        if (c->m_data == n) {
+        if (c->m_data.node() == n) {
             m_size--;
             if (prev == nullptr) {
                 if (next == nullptr) {
@@ -1442,6 +1460,9 @@ void ast_manager::init() {
     m_expr_id_gen.reset(0);
     m_decl_id_gen.reset(c_first_decl_id);
     m_some_value_proc = nullptr;
+    m_rewrite_cache = nullptr;
+    m_mux = nullptr;
+    m_scratch_lvl = 0;
     m_basic_family_id          = mk_family_id("basic");
     m_label_family_id          = mk_family_id("label");
     m_pattern_family_id        = mk_family_id("pattern");
@@ -1466,6 +1487,12 @@ void ast_manager::init() {
     inc_ref(m_false);
 }
 
+expr_lru_cache & ast_manager::rewrite_cache() {
+    if (!m_rewrite_cache)
+        m_rewrite_cache = alloc(expr_lru_cache, *this, 0);
+    return *m_rewrite_cache;
+}
+
 
 template<typename T>
 static void mark_array_ref(ast_mark& mark, unsigned sz, T * const * a) {
@@ -1486,6 +1513,13 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
 
+    dealloc(m_rewrite_cache);
+    m_rewrite_cache = nullptr;
+    set_concurrent(false);
+    if (m_scratch_lvl > 0) {
+        m_scratch_lvl = 1;
+        pop_scratch();
+    }
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
     dec_ref(m_true);
@@ -1553,7 +1587,7 @@ ast_manager::~ast_manager() {
                 else {
                     std::cout << mk_ll_pp(a, *this, false) << "id: " << a->get_id() << "\n";
                 });
-            a->m_ref_count = 0;
+            a->set_ref_count(0);
             delete_node(a);
         }
     }
@@ -1569,6 +1603,7 @@ ast_manager::~ast_manager() {
 }
 
 void ast_manager::compact_memory() {
+    SASSERT(!in_scratch());
     m_alloc.consolidate();
     unsigned capacity = m_ast_table.capacity();
     if (capacity > 4*m_ast_table.size()) {
@@ -1585,6 +1620,7 @@ void ast_manager::compact_memory() {
 }
 
 void ast_manager::compress_ids() {
+    SASSERT(!in_scratch());
     ptr_vector<ast> asts;
     m_expr_id_gen.cleanup();
     m_decl_id_gen.cleanup(c_first_decl_id);
@@ -1799,19 +1835,32 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 #endif
 
 ast * ast_manager::register_node_core(ast * n) {
-    unsigned h = get_node_hash(n);
+    return register_node_core(n, get_node_hash(n));
+}
+
+ast * ast_manager::register_node_core(ast * n, unsigned h) {
+    SASSERT(h == get_node_hash(n));
     n->m_hash = h;
 #ifdef Z3DEBUG
-    bool contains = m_ast_table.contains(n);
+    bool contains = this->contains(n);
     CASSERT("nondet_bug", contains || slow_not_contains(n));
 #endif
 
-    ast* r = m_ast_table.insert_if_not_there(n);    
+    ast_slot s(n), f;
+    ast* r;
+    if (m_scratch_lvl == 0)
+        r = m_ast_table.insert_if_not_there(s);
+    else if (m_ast_table.find(s, f))
+        r = f;
+    else {
+        n->m_scratch = true;
+        r = m_scratch_table.insert_if_not_there(s);
+    }
 
     SASSERT(r->m_hash == h);
     if (r != n) {
         SASSERT(contains);
-        SASSERT(m_ast_table.contains(n));
+        SASSERT(this->contains(n));
         if (is_func_decl(r) && to_func_decl(r)->get_range() != to_func_decl(n)->get_range()) {
             std::ostringstream buffer;
             buffer << "Recycling of declaration for the same name '" << to_func_decl(r)->get_name().str()
@@ -1823,7 +1872,7 @@ ast * ast_manager::register_node_core(ast * n) {
     }
     else {
         SASSERT(!contains);
-        SASSERT(m_ast_table.contains(n));
+        SASSERT(this->contains(n));
     }
 
     n->m_id = is_decl(n) ? m_decl_id_gen.mk() : m_expr_id_gen.mk();
@@ -1917,16 +1966,76 @@ ast * ast_manager::register_node_core(ast * n) {
 }
 
 
+void ast_manager::dec_ref_concurrent(ast * n) {
+    if (n->dec_ref_atomic() == 0) {
+        concurrent_lock lock(*this);
+        m_zombies.insert(n);
+    }
+}
+
+void ast_manager::collect_garbage() {
+    ptr_vector<ast> todo;
+    for (ast * n : m_zombies)
+        if (n->get_ref_count() == 0)
+            todo.push_back(n);
+    m_zombies.reset();
+    // the nodes in todo do not reference each other, a node with a parent has a positive reference count.
+    for (ast * n : todo)
+        delete_node(n);
+}
+
+void ast_manager::set_concurrent(bool f) {
+    if (f && !m_mux)
+        m_mux = alloc(recursive_mutex);
+    else if (!f && m_mux) {
+        collect_garbage();
+        dealloc(m_mux);
+        m_mux = nullptr;
+    }
+}
+
+void ast_manager::pop_scratch() {
+    SASSERT(m_scratch_lvl > 0);
+    if (--m_scratch_lvl > 0)
+        return;
+    // Pin the unreferenced nodes, so none of them is deleted
+    // as the child of another one before it is released.
+    ptr_vector<ast> dead;
+    for (ast * n : m_scratch_table) {
+        if (n->get_ref_count() == 0) {
+            n->inc_ref();
+            dead.push_back(n);
+        }
+    }
+    for (ast * n : dead)
+        dec_ref(n);
+    TRACE("scratch", tout << "released: " << dead.size() << " promoted: " << m_scratch_table.size() << "\n";);
+    for (ast * n : m_scratch_table) {
+        n->m_scratch = false;
+        m_ast_table.insert(n);
+    }
+    m_scratch_table.reset();
+}
+
 void ast_manager::delete_node(ast * n) {
     TRACE("delete_node_bug", tout << mk_ll_pp(n, *this) << "\n";);
 
-    SASSERT(m_ast_table.contains(n));
-    m_ast_table.push_erase(n);
+    if (n->m_scratch) {
+        // deleted in bulk when the scratch scope is closed.
+        if (m_scratch_lvl > 0)
+            return;
+        SASSERT(m_scratch_table.contains(n));
+        m_scratch_table.push_erase(n);
+    }
+    else {
+        SASSERT(m_ast_table.contains(n));
+        m_ast_table.push_erase(n);
+    }
 
-    while ((n = m_ast_table.pop_erase())) {
+    while ((n = m_ast_table.pop_erase()) || (n = m_scratch_table.pop_erase())) {
 
         CTRACE("del_quantifier", is_quantifier(n), tout << "deleting quantifier " << n->m_id << " " << n << "\n";);
-        TRACE("mk_var_bug", tout << "del_ast: " << " " << n->m_ref_count << "\n";);
+        TRACE("mk_var_bug", tout << "del_ast: " << " " << n->get_ref_count() << "\n";);
         TRACE("ast_delete_node", tout << mk_bounded_pp(n, *this) << "\n";);
 
         SASSERT(!m_debug_ref_count || !m_debug_free_indices.contains(n->m_id));
@@ -1992,6 +2101,7 @@ void ast_manager::delete_node(ast * n) {
 
 
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
+    concurrent_lock lock(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_sort(k, num_parameters, parameters);
@@ -2000,6 +2110,7 @@ sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters,
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned arity, sort * const * domain, sort * range) {
+    concurrent_lock lock(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, arity, domain, range);
@@ -2008,6 +2119,7 @@ func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_p
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned num_args, expr * const * args, sort * range) {
+    concurrent_lock lock(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, num_args, args, range);
@@ -2041,6 +2153,7 @@ app * ast_manager::mk_app(family_id fid, decl_kind k, expr * arg1, expr * arg2,
 }
 
 sort * ast_manager::mk_sort(symbol const & name, sort_info * info) {
+    concurrent_lock lock(*this);
     unsigned sz      = sort::get_obj_size();
     void * mem       = allocate_node(sz);
     sort * new_node  = new (mem) sort(name, info);
@@ -2091,6 +2204,7 @@ func_decl * ast_manager::mk_func_decl(symbol const & name, unsigned arity, sort
 }
 
 func_decl * ast_manager::mk_func_decl(symbol const & name, unsigned arity, sort * const * domain, sort * range, func_decl_info * info) {
+    concurrent_lock lock(*this);
     SASSERT(arity == 1 || info == 0 || !info->is_injective());
     SASSERT(arity == 2 || info == 0 || !info->is_associative());
     SASSERT(arity == 2 || info == 0 || !info->is_commutative());
@@ -2222,12 +2336,21 @@ expr* ast_manager::coerce_to(expr* e, sort* s) {
 }
 
 app * ast_manager::mk_app_core(func_decl * decl, unsigned num_args, expr * const * args) {
+    concurrent_lock lock(*this);
     app * r = nullptr;
     app * new_node = nullptr;
     unsigned sz = app::get_obj_size(num_args);
+    bool coerce = m_int_real_coercions && coercion_needed(decl, num_args, args);
+    // load the bucket of the node while the node is built.
+    // The arguments of a coerced node differ from args, so its hash is computed when it is registered.
+    unsigned h = 0;
+    if (!coerce) {
+        h = ast_array_hash(args, num_args, decl->hash());
+        m_ast_table.prefetch(h);
+    }
     void * mem = allocate_node(sz);
     try {
-        if (m_int_real_coercions && coercion_needed(decl, num_args, args)) {
+        if (coerce) {
             expr_ref_buffer new_args(*this);
             for (unsigned i = 0; i < num_args; i++) {
                 sort * d = decl->is_associative() ? decl->get_domain(0) : decl->get_domain(i);
@@ -2241,7 +2364,7 @@ app * ast_manager::mk_app_core(func_decl * decl, unsigned num_args, expr * const
         else {
             check_args(decl, num_args, args);
             new_node = new (mem)app(decl, num_args, args);
-            r = register_node(new_node);
+            r = register_node(new_node, h);
         }
 
         if (m_trace_stream && r == new_node) {
@@ -2352,6 +2475,7 @@ app * ast_manager::mk_app(func_decl * decl, unsigned num_args, expr * const * ar
 
 func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const & suffix, unsigned arity,
                                             sort * const * domain, sort * range, bool skolem) {
+    concurrent_lock lock(*this);
     func_decl_info info(null_family_id, null_decl_kind);
     info.m_skolem = skolem;
     SASSERT(skolem == info.is_skolem());
@@ -2378,6 +2502,7 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
 }
 
 sort * ast_manager::mk_fresh_sort(char const * prefix) {
+    concurrent_lock lock(*this);
     string_buffer<32> buffer;
     buffer << prefix << "!" << m_fresh_id;
     m_fresh_id++;
@@ -2385,6 +2510,7 @@ sort * ast_manager::mk_fresh_sort(char const * prefix) {
 }
 
 symbol ast_manager::mk_fresh_var_name(char const * prefix) {
+    concurrent_lock lock(*this);
     string_buffer<32> buffer;
     buffer << (prefix ? prefix : "var") << "!" << m_fresh_id;
     m_fresh_id++;
@@ -2392,6 +2518,7 @@ symbol ast_manager::mk_fresh_var_name(char const * prefix) {
 }
 
 var * ast_manager::mk_var(unsigned idx, sort * s) {
+    concurrent_lock lock(*this);
     unsigned sz     = var::get_obj_size();
     void * mem      = allocate_node(sz);
     var * new_node  = new (mem) var(idx, s);
@@ -2498,6 +2625,7 @@ quantifier * ast_manager::mk_quantifier(quantifier_kind k, unsigned num_decls, s
                                         expr * body, int weight , symbol const & qid, symbol const & skid,
                                         unsigned num_patterns, expr * const * patterns,
                                         unsigned num_no_patterns, expr * const * no_patterns) {
+    concurrent_lock lock(*this);
     SASSERT(body);
     SASSERT(num_decls > 0);
     if (num_patterns != 0 && num_no_patterns != 0)
@@ -2537,6 +2665,7 @@ quantifier * ast_manager::mk_quantifier(quantifier_kind k, unsigned num_decls, s
 }
 
 quantifier * ast_manager::mk_lambda(unsigned num_decls, sort * const * decl_sorts, symbol const * decl_names, expr * body) {
+    concurrent_lock lock(*this);
     SASSERT(body);
     unsigned sz               = quantifier::get_obj_size(num_decls, 0, 0);
     void * mem                = allocate_node(sz);
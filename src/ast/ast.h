@@ -46,6 +46,7 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/dependency.h"
 #include "util/rlimit.h"
+#include "util/mutex.h"
 
 #define RECYCLE_FREE_AST_INDICES
 
@@ -466,11 +467,19 @@ protected:
     //    shared_occs used one of the public marks.
     //  - This was a constant source of assertion violations.
     unsigned m_mark_shared_occs:1;
+    // The node is stored in the scratch table of its manager, see ast_manager::push_scratch.
+    unsigned m_scratch:1;
     friend class shared_occs_mark;
     void mark_so(bool flag) { m_mark_shared_occs = flag; }
     void reset_mark_so() { m_mark_shared_occs = false; }
     bool is_marked_so() const { return m_mark_shared_occs; }
+#ifdef SINGLE_THREAD
     unsigned m_ref_count;
+#else
+    // The reference count is only updated atomically when the manager is concurrent.
+    // Otherwise relaxed loads and stores are used, they compile to plain memory accesses.
+    std::atomic<unsigned> m_ref_count;
+#endif
     unsigned m_hash;
 #ifdef Z3DEBUG
     // In debug mode, we store who is the owner of the mark.
@@ -478,17 +487,30 @@ protected:
     void *   m_mark2_owner;
 #endif
 
+#ifdef SINGLE_THREAD
+    unsigned ref_count() const { return m_ref_count; }
+    void set_ref_count(unsigned c) { m_ref_count = c; }
+    void inc_ref_atomic() { inc_ref(); }
+    unsigned dec_ref_atomic() { return dec_ref(); }
+#else
+    unsigned ref_count() const { return m_ref_count.load(std::memory_order_relaxed); }
+    void set_ref_count(unsigned c) { m_ref_count.store(c, std::memory_order_relaxed); }
+    void inc_ref_atomic() { m_ref_count.fetch_add(1, std::memory_order_relaxed); }
+    unsigned dec_ref_atomic() { return m_ref_count.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+#endif
+
     void inc_ref() {
-        SASSERT(m_ref_count < UINT_MAX);
-        m_ref_count ++;
+        SASSERT(ref_count() < UINT_MAX);
+        set_ref_count(ref_count() + 1);
     }
 
-    void dec_ref() {
-        SASSERT(m_ref_count > 0);
-        --m_ref_count;
+    unsigned dec_ref() {
+        SASSERT(ref_count() > 0);
+        set_ref_count(ref_count() - 1);
+        return ref_count();
     }
 
-    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_ref_count(0) {
+    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_scratch(false), m_ref_count(0) {
         DEBUG_CODE({
             m_mark1_owner = 0;
             m_mark2_owner = 0;
@@ -496,7 +518,7 @@ protected:
     }
 public:
     unsigned get_id() const { return m_id; }
-    unsigned get_ref_count() const { return m_ref_count; }
+    unsigned get_ref_count() const { return ref_count(); }
     ast_kind get_kind() const { return static_cast<ast_kind>(m_kind); }
     unsigned hash() const { return m_hash; }
 
@@ -690,18 +712,18 @@ class app : public expr {
 
     func_decl *  m_decl;
     unsigned     m_num_args;
+    // remark: the flags occupy the padding between m_num_args and m_args,
+    // so they do not add to the size of the node.
+    app_flags    m_flags;
     expr *       m_args[0];
 
-    static app_flags g_constant_flags;
-
-    // remark: store term depth in the end of the app. the depth is only stored if the num_args > 0
     static unsigned get_obj_size(unsigned num_args) {
-        return num_args == 0 ? sizeof(app) : sizeof(app) + num_args * sizeof(expr *) + sizeof(app_flags);
+        return sizeof(app) + num_args * sizeof(expr *);
     }
 
     friend class tmp_app;
 
-    app_flags * flags() const { return m_num_args == 0 ? &g_constant_flags : reinterpret_cast<app_flags*>(const_cast<expr**>(m_args + m_num_args)); }
+    app_flags * flags() const { return const_cast<app_flags*>(&m_flags); }
 
     app(func_decl * decl, unsigned num_args, expr * const * args);
 public:
@@ -960,11 +982,79 @@ struct ast_eq_proc {
 };
 
 class ast_translation;
+class expr_lru_cache;
+
+/**
+   \brief Entry of the hash-consing table.
+   On 64-bit targets the upper 16 bits of node addresses are zero, and the slot keeps
+   a 16-bit fingerprint of the hash code of the node there. Probing a chain compares these
+   fingerprints and only compares nodes when they agree. The lowest bit of the slot is
+   set if it has a fingerprint; a node at an address that uses the upper bits is
+   stored without one.
+*/
+class ast_slot {
+#if UINTPTR_MAX > 0xFFFFFFFFu
+    static const unsigned  fp_shift = 48;
+    static const uintptr_t fp_tag   = 1;
+    uintptr_t m_bits;
+
+    static uintptr_t mk(ast * n) {
+        uintptr_t p = reinterpret_cast<uintptr_t>(n);
+        SASSERT((p & fp_tag) == 0);
+        if ((p >> fp_shift) != 0)
+            return p;
+        // the low bits of the hash code select the bucket; mix the bits so the fingerprint also depends on them
+        unsigned fp = (n->hash() * 2654435761u) >> 16;
+        return p | (static_cast<uintptr_t>(fp) << fp_shift) | fp_tag;
+    }
+public:
+    ast_slot():m_bits(0) {}
+    ast_slot(ast * n):m_bits(mk(n)) {}
+    ast * node() const {
+        if ((m_bits & fp_tag) == 0)
+            return reinterpret_cast<ast*>(m_bits);
+        return reinterpret_cast<ast*>(m_bits & ((static_cast<uintptr_t>(1) << fp_shift) - 1) & ~fp_tag);
+    }
+    // false if the fingerprints show that the nodes differ
+    bool may_equal(ast_slot const & s) const {
+        return (m_bits & s.m_bits & fp_tag) == 0 || (m_bits >> fp_shift) == (s.m_bits >> fp_shift);
+    }
+#else
+    ast * m_node;
+public:
+    ast_slot():m_node(nullptr) {}
+    ast_slot(ast * n):m_node(n) {}
+    ast * node() const { return m_node; }
+    bool may_equal(ast_slot const & s) const { return true; }
+#endif
+    operator ast*() const { return node(); }
 
-class ast_table : public chashtable<ast*, obj_ptr_hash<ast>, ast_eq_proc> {
+    struct hash_proc {
+        unsigned operator()(ast_slot const & s) const { return s.node()->hash(); }
+    };
+    struct eq_proc {
+        bool operator()(ast_slot const & s1, ast_slot const & s2) const {
+            if (!s1.may_equal(s2))
+                return false;
+            ast * n1 = s1.node(), * n2 = s2.node();
+            return n1 == n2 || compare_nodes(n1, n2);
+        }
+    };
+};
+
+class ast_table : public chashtable<ast_slot, ast_slot::hash_proc, ast_slot::eq_proc> {
 public:
     void push_erase(ast * n);
     ast* pop_erase();
+
+    /**
+       \brief start loading the bucket of a node with hash code h.
+    */
+    void prefetch(unsigned h) const {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(m_table + (h & (m_slots - 1)));
+#endif
+    }
 };
 
 // -----------------------------------
@@ -1551,6 +1641,11 @@ protected:
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
     symbol                    m_lambda_def;
+    expr_lru_cache *          m_rewrite_cache;  // rewrite results kept across calls, see th_rewriter.
+    recursive_mutex *         m_mux;            // not null if the manager is shared between threads.
+    obj_hashtable<ast>        m_zombies;        // unreferenced nodes of a concurrent manager, see collect_garbage.
+    ast_table                 m_scratch_table;  // nodes created in a scratch scope, see push_scratch.
+    unsigned                  m_scratch_lvl;
 
     void init();
 
@@ -1567,6 +1662,67 @@ public:
 
     // propagate cancellation signal to decl_plugins
 
+    /**
+       \brief Allow threads to create and release terms of this manager concurrently.
+
+       In concurrent mode reference counts are updated atomically, and terms, sorts and
+       declarations are created under a lock of the manager, so threads can share terms
+       without translating them to separate managers.
+       Hash-consing may return a node whose last reference is being released by another
+       thread, so nodes are not deleted when their reference count drops to zero.
+       They are deleted by collect_garbage, or when the concurrent mode is disabled.
+       The mode must be changed while a single thread uses the manager.
+       Marks, expression arrays, dependencies and the caches of utilities that sit on
+       top of the manager are not protected.
+    */
+    void set_concurrent(bool f);
+    bool is_concurrent() const { return m_mux != nullptr; }
+
+    /**
+       \brief delete the nodes of a concurrent manager that are no longer referenced.
+       It must be called while a single thread uses the manager.
+    */
+    void collect_garbage();
+
+    /**
+       \brief lock the manager if it is concurrent, see set_concurrent.
+    */
+    class concurrent_lock {
+        recursive_mutex * m_mux;
+    public:
+        concurrent_lock(ast_manager & m): m_mux(m.m_mux) { if (m_mux) m_mux->lock(); }
+        ~concurrent_lock() { if (m_mux) m_mux->unlock(); }
+    };
+
+    /**
+       \brief open a scratch scope for short lived terms.
+
+       Nodes created in a scratch scope are hash-consed into a separate scratch table,
+       and they are not deleted when their reference count drops to zero, so temporaries
+       that are rebuilt in the scope are found again instead of being recreated.
+       When the outermost scope is closed, the unreferenced scratch nodes are deleted in bulk,
+       and the nodes that are still referenced are moved to the main table.
+       Scopes are ignored when the manager is concurrent.
+    */
+    void push_scratch() { if (!m_mux) ++m_scratch_lvl; }
+    void pop_scratch();
+    bool in_scratch() const { return m_scratch_lvl > 0; }
+
+    class scratch_scope {
+        ast_manager & m;
+        bool          m_active;
+    public:
+        scratch_scope(ast_manager & m, bool active = true): m(m), m_active(active && !m.is_concurrent()) { if (m_active) m.push_scratch(); }
+        ~scratch_scope() { if (m_active) m.pop_scratch(); }
+    };
+
+    /**
+       \brief cache of rewrite results shared by the rewriters of this manager.
+       It is created on first use and released with the manager.
+    */
+    expr_lru_cache & rewrite_cache();
+    bool has_rewrite_cache() const { return m_rewrite_cache != nullptr; }
+
     bool has_trace_stream() const { return m_trace_stream != nullptr; }
     std::ostream & trace_stream() { SASSERT(has_trace_stream()); return *m_trace_stream; }
     struct suspend_trace {
@@ -1666,7 +1822,7 @@ public:
 
     bool are_distinct(expr * a, expr * b) const;
 
-    bool contains(ast * a) const { return m_ast_table.contains(a); }
+    bool contains(ast * a) const { return m_ast_table.contains(a) || (!m_scratch_table.empty() && m_scratch_table.contains(a)); }
     
     bool is_lambda_def(quantifier* q) const { return q->get_qid() == m_lambda_def; }
     void add_lambda_def(func_decl* f, quantifier* q);
@@ -1675,19 +1831,24 @@ public:
 
     symbol const& lambda_def_qid() const { return m_lambda_def; }
 
-    unsigned get_num_asts() const { return m_ast_table.size(); }
+    unsigned get_num_asts() const { return m_ast_table.size() + m_scratch_table.size(); }
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
     void inc_ref(ast* n) {
-        if (n) 
-            n->inc_ref();
+        if (n) {
+            if (m_mux)
+                n->inc_ref_atomic();
+            else
+                n->inc_ref();
+        }
     }
     
     void dec_ref(ast* n) {
         if (n) {
-            n->dec_ref();
-            if (n->get_ref_count() == 0)
+            if (m_mux)
+                dec_ref_concurrent(n);
+            else if (n->dec_ref() == 0)
                 delete_node(n);
         }
     }
@@ -1716,14 +1877,22 @@ public:
 
 protected:
     ast * register_node_core(ast * n);
+    ast * register_node_core(ast * n, unsigned h);
 
     template<typename T>
     T * register_node(T * n) {
         return static_cast<T *>(register_node_core(n));
     }
 
+    template<typename T>
+    T * register_node(T * n, unsigned h) {
+        return static_cast<T *>(register_node_core(n, h));
+    }
+
     void delete_node(ast * n);
 
+    void dec_ref_concurrent(ast * n);
+
     void * allocate_node(unsigned size) {
         return m_alloc.allocate(size);
     }
@@ -2402,9 +2571,11 @@ protected:
 
 private:
     void push_dec_ref(ast * n) {
-        n->dec_ref();
-        if (n->get_ref_count() == 0) {
-            m_ast_table.push_erase(n);
+        if ((m_mux ? n->dec_ref_atomic() : n->dec_ref()) == 0) {
+            if (!n->m_scratch)
+                m_ast_table.push_erase(n);
+            else if (m_scratch_lvl == 0)
+                m_scratch_table.push_erase(n);
         }
     }
 
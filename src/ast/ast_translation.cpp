@@ -26,9 +26,25 @@ Revision History:
 #include "ast/ast_pp.h"
 
 ast_translation::~ast_translation() {
+    if (m_inverse)
+        m_inverse->m_inverse = nullptr;
     reset_cache();
 }
 
+void ast_translation::set_inverse(ast_translation & inv) {
+    SASSERT(&inv.from() == &to() && &inv.to() == &from());
+    SASSERT(m_persistent && inv.m_persistent);
+    SASSERT(!m_frozen_from && !inv.m_frozen_from);
+    m_inverse = &inv;
+    inv.m_inverse = this;
+}
+
+void ast_translation::collect_statistics(statistics & st) const {
+    st.update("translation nodes copied", m_num_copied);
+    st.update("translation nodes reused", m_hit_count);
+    st.update("translation cache size", m_cache.size());
+}
+
 void ast_translation::cleanup() {
     reset_cache();
     m_cache.finalize();
@@ -39,19 +55,28 @@ void ast_translation::cleanup() {
 
 void ast_translation::reset_cache() {
     for (auto & kv : m_cache) {
-        m_from_manager.dec_ref(kv.m_key);
+        if (!m_frozen_from)
+            m_from_manager.dec_ref(kv.m_key);
         m_to_manager.dec_ref(kv.m_value);
     }
     m_cache.reset();
 }
 
+void ast_translation::insert(ast * s, ast * t) {
+    if (!m_frozen_from)
+        m_from_manager.inc_ref(s);
+    m_to_manager.inc_ref(t);
+    m_cache.insert(s, t);
+    ++m_insert_count;
+}
+
 void ast_translation::cache(ast * s, ast * t) {
     SASSERT(!m_cache.contains(s));
-    if (s->get_ref_count() > 1) {
-        m_from_manager.inc_ref(s);
-        m_to_manager.inc_ref(t);
-        m_cache.insert(s, t);
-        ++m_insert_count;
+    ++m_num_copied;
+    if (use_cache(s)) {
+        insert(s, t);
+        if (m_inverse && !m_inverse->m_cache.contains(t))
+            m_inverse->insert(t, s);
     }
 }
 
@@ -77,7 +102,7 @@ void ast_translation::push_frame(ast * n) {
 }
 
 bool ast_translation::visit(ast * n) {        
-    if (n->get_ref_count() > 1) {
+    if (use_cache(n)) {
         ast * r;
         if (m_cache.find(n, r)) {
             m_result_stack.push_back(r);
@@ -196,7 +221,7 @@ ast * ast_translation::process(ast const * _n) {
     SASSERT(m_extra_children_stack.empty());
     
     ++m_num_process;
-    if (m_num_process > (1 << 14)) {
+    if (m_num_process > (1 << 14) && !m_persistent) {
         reset_cache();
         m_num_process = 0;
     }
@@ -208,7 +233,7 @@ ast * ast_translation::process(ast const * _n) {
             ast * n = fr.m_n;
             ast * r;         
             TRACE("ast_translation", tout << mk_ll_pp(n, m_from_manager, false) << "\n";);
-            if (fr.m_idx == 0 && n->get_ref_count() > 1) {
+            if (fr.m_idx == 0 && use_cache(n)) {
                 if (m_cache.find(n, r)) {
                     SASSERT(m_result_stack.size() == fr.m_rpos);
                     m_result_stack.push_back(r);
@@ -21,6 +21,7 @@ Revision History:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/statistics.h"
 
 class ast_translation {
     struct frame {
@@ -41,8 +42,14 @@ class ast_translation {
     unsigned            m_miss_count;
     unsigned            m_insert_count;
     unsigned            m_num_process;
+    unsigned            m_num_copied;
+    bool                m_frozen_from;
+    bool                m_persistent;
+    ast_translation *   m_inverse;
 
     void cache(ast * s, ast * t);
+    void insert(ast * s, ast * t);
+    bool use_cache(ast * n) const { return m_persistent || n->get_ref_count() > 1; }
     void collect_decl_extra_children(decl * d);
     void push_frame(ast * n);
     bool visit(ast * n);
@@ -59,6 +66,10 @@ public:
         m_miss_count = 0;
         m_insert_count = 0;
         m_num_process = 0;
+        m_num_copied = 0;
+        m_frozen_from = false;
+        m_persistent = false;
+        m_inverse = nullptr;
         if (&from != &to) {
             if (copy_plugins)
                 m_to_manager.copy_families_plugins(m_from_manager);
@@ -95,11 +106,39 @@ public:
 
     void reset_cache();
     void cleanup();
+
+    /**
+       \brief The source manager is treated as a read-only snapshot whose nodes are
+       kept alive by the caller. Reference counts in the source are left untouched,
+       so several translations out of the same source can run concurrently
+       as long as nobody modifies the source manager meanwhile.
+    */
+    void freeze_from() { SASSERT(m_cache.empty()); m_frozen_from = true; }
+    bool is_from_frozen() const { return m_frozen_from; }
+
+    /**
+       \brief Keep the translation of every node, not only of shared nodes, and never
+       flush the cache. Repeated translations of overlapping terms then only copy the
+       nodes that were not translated before. The cache keeps the translated nodes alive
+       until reset_cache or the destruction of the translation.
+    */
+    void set_persistent(bool f) { m_persistent = f; }
+    bool is_persistent() const { return m_persistent; }
+
+    /**
+       \brief Pair this persistent translation with a persistent translation in the
+       opposite direction. Every node copied by one of them is recorded in the other,
+       so translating a copy back returns the original node.
+    */
+    void set_inverse(ast_translation & inv);
+
+    void collect_statistics(statistics & st) const;
     
     unsigned loop_count() const { return m_loop_count; }
     unsigned hit_count() const { return m_hit_count; }
     unsigned miss_count() const { return m_miss_count; }
     unsigned insert_count() const { return m_insert_count; }
+    unsigned copied_count() const { return m_num_copied; }
     unsigned long long get_num_collision() const { return m_cache.get_num_collision(); }
 };
 
@@ -0,0 +1,130 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    expr_lru_cache.cpp
+
+Abstract:
+
+    (expr, tag) -> expr cache with a bounded number of entries.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020
+
+Notes:
+
+--*/
+#include "ast/expr_lru_cache.h"
+
+expr_lru_cache::expr_lru_cache(ast_manager & m, unsigned capacity):
+    m(m),
+    m_capacity(capacity) {
+    entry sentinel = { nullptr, 0, nullptr, 0, 0 };
+    m_entries.push_back(sentinel);
+}
+
+expr_lru_cache::~expr_lru_cache() {
+    reset();
+}
+
+void expr_lru_cache::unlink(unsigned i) {
+    entry & e = m_entries[i];
+    m_entries[e.m_prev].m_next = e.m_next;
+    m_entries[e.m_next].m_prev = e.m_prev;
+}
+
+void expr_lru_cache::push_front(unsigned i) {
+    entry & e = m_entries[i];
+    e.m_prev = 0;
+    e.m_next = m_entries[0].m_next;
+    m_entries[e.m_next].m_prev = i;
+    m_entries[0].m_next = i;
+}
+
+void expr_lru_cache::evict(unsigned i) {
+    entry & e = m_entries[i];
+    unlink(i);
+    m_table.erase(key_t(e.m_key, e.m_tag));
+    m.dec_ref(e.m_key);
+    m.dec_ref(e.m_value);
+    e.m_key = nullptr;
+    e.m_value = nullptr;
+    m_free.push_back(i);
+}
+
+expr * expr_lru_cache::find(expr * k, unsigned tag) {
+    unsigned i;
+    if (!m_table.find(key_t(k, tag), i)) {
+        m_stats.m_misses++;
+        return nullptr;
+    }
+    m_stats.m_hits++;
+    unlink(i);
+    push_front(i);
+    return m_entries[i].m_value;
+}
+
+void expr_lru_cache::insert(expr * k, unsigned tag, expr * v) {
+    if (m_capacity == 0)
+        return;
+    unsigned i;
+    if (m_table.find(key_t(k, tag), i)) {
+        entry & e = m_entries[i];
+        m.inc_ref(v);
+        m.dec_ref(e.m_value);
+        e.m_value = v;
+        unlink(i);
+        push_front(i);
+        return;
+    }
+    if (m_table.size() >= m_capacity) {
+        // the last entry of the list is the least recently used one
+        evict(m_entries[0].m_prev);
+        m_stats.m_evictions++;
+    }
+    if (m_free.empty()) {
+        i = m_entries.size();
+        m_entries.push_back(entry());
+    }
+    else {
+        i = m_free.back();
+        m_free.pop_back();
+    }
+    entry & e = m_entries[i];
+    e.m_key = k;
+    e.m_tag = tag;
+    e.m_value = v;
+    m.inc_ref(k);
+    m.inc_ref(v);
+    m_table.insert(key_t(k, tag), i);
+    push_front(i);
+}
+
+void expr_lru_cache::set_capacity(unsigned capacity) {
+    m_capacity = capacity;
+    while (m_table.size() > m_capacity)
+        evict(m_entries[0].m_prev);
+}
+
+void expr_lru_cache::reset() {
+    for (unsigned i = 1; i < m_entries.size(); ++i) {
+        entry & e = m_entries[i];
+        if (e.m_key) {
+            m.dec_ref(e.m_key);
+            m.dec_ref(e.m_value);
+        }
+    }
+    m_table.reset();
+    m_entries.shrink(1);
+    m_entries[0].m_prev = m_entries[0].m_next = 0;
+    m_free.reset();
+}
+
+void expr_lru_cache::collect_statistics(statistics & st) const {
+    st.update("rewriter persistent cache hits", m_stats.m_hits);
+    st.update("rewriter persistent cache misses", m_stats.m_misses);
+    st.update("rewriter persistent cache evictions", m_stats.m_evictions);
+    st.update("rewriter persistent cache size", size());
+}
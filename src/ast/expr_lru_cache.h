@@ -0,0 +1,90 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    expr_lru_cache.h
+
+Abstract:
+
+    (expr, tag) -> expr cache with a bounded number of entries.
+    When the cache is full, the least recently used entry is evicted.
+    The cache owns references to the keys and values it stores.
+
+    ast_manager owns a cache of this kind that th_rewriter uses to keep
+    top-level rewrite results across calls. The tag is the hash of the
+    rewriter parameters.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020
+
+Notes:
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/chashtable.h"
+#include "util/statistics.h"
+
+class expr_lru_cache {
+    typedef std::pair<expr*, unsigned> key_t;
+    struct key_hash {
+        unsigned operator()(key_t const& k) const {
+            return combine_hash(k.first->hash(), k.second);
+        }
+    };
+    typedef cmap<key_t, unsigned, key_hash, default_eq<key_t> > map;
+
+    struct entry {
+        expr *   m_key;
+        unsigned m_tag;
+        expr *   m_value;
+        unsigned m_prev;
+        unsigned m_next;
+    };
+
+    struct stats {
+        unsigned m_hits;
+        unsigned m_misses;
+        unsigned m_evictions;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    ast_manager &    m;
+    map              m_table;     // (key, tag) -> index in m_entries
+    svector<entry>   m_entries;   // m_entries[0] is the sentinel of the list ordered by recent use
+    unsigned_vector  m_free;
+    unsigned         m_capacity;
+    stats            m_stats;
+
+    void unlink(unsigned i);
+    void push_front(unsigned i);
+    void evict(unsigned i);
+
+public:
+    expr_lru_cache(ast_manager & m, unsigned capacity);
+    ~expr_lru_cache();
+
+    /**
+       \brief return the value stored for (k, tag), or nullptr if there is none.
+       A found entry becomes the most recently used one.
+    */
+    expr * find(expr * k, unsigned tag);
+
+    void insert(expr * k, unsigned tag, expr * v);
+
+    /**
+       \brief set the maximal number of entries, evicting entries if needed.
+    */
+    void set_capacity(unsigned capacity);
+    unsigned capacity() const { return m_capacity; }
+    unsigned size() const { return m_table.size(); }
+
+    void reset();
+
+    void collect_statistics(statistics & st) const;
+    void reset_statistics() { m_stats.reset(); }
+};
@@ -720,6 +720,7 @@ unsigned bit_blaster_rewriter::get_num_steps() const {
 
 void bit_blaster_rewriter::cleanup() {
     m_imp->cleanup();
+    m_imp->m_blaster.reset_circuit_cache();
 }
 
 obj_map<func_decl, expr*> const & bit_blaster_rewriter::const2bits() const {
@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "util/rational.h"
+#include "util/hashtable.h"
 
 template<typename Cfg>
 class bit_blaster_tpl : public Cfg {
@@ -39,18 +40,74 @@ protected:
     bool               m_use_bcm; /* Booth Multiplier for constants */
     void checkpoint();
 
+    /**
+       \brief Cache of multiplier and divider circuits keyed by the operator and the operand bits.
+       Terms that share operands (e.g., bvudiv and bvurem over the same arguments) reuse the same circuit.
+    */
+    enum circuit_kind { MUL_CIRCUIT, UDIV_UREM_CIRCUIT };
+    struct circuit {
+        unsigned m_kind;
+        unsigned m_sz;
+        unsigned m_args;   // offset of the operand bits in m_circuit_bits
+        unsigned m_outs;   // offset of the output bits in m_circuit_bits
+        unsigned m_hash;
+    };
+    struct circuit_hash_proc {
+        svector<circuit> const * m_circuits;
+        circuit_hash_proc(svector<circuit> const * cs = nullptr): m_circuits(cs) {}
+        unsigned operator()(unsigned idx) const { return (*m_circuits)[idx].m_hash; }
+    };
+    struct circuit_eq_proc {
+        svector<circuit> const * m_circuits;
+        ptr_vector<expr> const * m_bits;
+        circuit_eq_proc(svector<circuit> const * cs = nullptr, ptr_vector<expr> const * bits = nullptr): m_circuits(cs), m_bits(bits) {}
+        bool operator()(unsigned i, unsigned j) const;
+    };
+    typedef hashtable<unsigned, circuit_hash_proc, circuit_eq_proc> circuit_table;
+    bool               m_use_circuit_cache;
+    ast_manager *      m_circuit_manager;
+    svector<circuit>   m_circuits;
+    ptr_vector<expr>   m_circuit_bits;
+    circuit_table      m_circuit_table;
+    unsigned           m_num_circuit_hits;
+
+    void push_circuit_bits(unsigned sz, expr * const * bits);
+    bool find_circuit(circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits, unsigned & idx);
+    void insert_circuit(unsigned idx, expr_ref_vector const & out1, expr_ref_vector const * out2);
+    void get_circuit(unsigned idx, unsigned i, expr_ref_vector & out_bits);
+    void mk_multiplier_core(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void mk_udiv_urem_core(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits);
+
 public:
     bit_blaster_tpl(Cfg const & cfg = Cfg(), unsigned long long max_memory = UINT64_MAX, bool use_wtm = false, bool use_bcm=false):
         Cfg(cfg),
         m_max_memory(max_memory),
         m_use_wtm(use_wtm),
-        m_use_bcm(use_bcm) {
+        m_use_bcm(use_bcm),
+        m_use_circuit_cache(true),
+        m_circuit_manager(nullptr),
+        m_circuit_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, circuit_hash_proc(&m_circuits), circuit_eq_proc(&m_circuits, &m_circuit_bits)),
+        m_num_circuit_hits(0) {
+    }
+
+    ~bit_blaster_tpl() {
+        reset_circuit_cache();
     }
 
     void set_max_memory(unsigned long long max_memory) {
         m_max_memory = max_memory;
     }
 
+    void set_use_circuit_cache(bool f) {
+        m_use_circuit_cache = f;
+        if (!f)
+            reset_circuit_cache();
+    }
+
+    void reset_circuit_cache();
+
+    unsigned get_num_circuit_hits() const { return m_num_circuit_hits; }
+
     
     // Cfg required API
     ast_manager & m() const { return Cfg::m(); }
@@ -168,8 +168,123 @@ void bit_blaster_tpl<Cfg>::mk_subtracter(unsigned sz, expr * const * a_bits, exp
     SASSERT(out_bits.size() == sz);
 }
 
+template<typename Cfg>
+bool bit_blaster_tpl<Cfg>::circuit_eq_proc::operator()(unsigned i, unsigned j) const {
+    circuit const & c1 = (*m_circuits)[i];
+    circuit const & c2 = (*m_circuits)[j];
+    if (c1.m_hash != c2.m_hash || c1.m_kind != c2.m_kind || c1.m_sz != c2.m_sz)
+        return false;
+    for (unsigned k = 0; k < 2 * c1.m_sz; ++k)
+        if ((*m_bits)[c1.m_args + k] != (*m_bits)[c2.m_args + k])
+            return false;
+    return true;
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::reset_circuit_cache() {
+    if (m_circuit_manager) {
+        for (expr * e : m_circuit_bits)
+            m_circuit_manager->dec_ref(e);
+    }
+    m_circuit_bits.reset();
+    m_circuits.reset();
+    m_circuit_table.reset();
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::push_circuit_bits(unsigned sz, expr * const * bits) {
+    for (unsigned i = 0; i < sz; i++) {
+        m_circuit_manager->inc_ref(bits[i]);
+        m_circuit_bits.push_back(bits[i]);
+    }
+}
+
+/**
+   \brief Return true if a circuit of kind k for the given operands was already created, and store its index in idx.
+   Otherwise, idx is the index of a new pending entry that must be completed with insert_circuit.
+*/
+template<typename Cfg>
+bool bit_blaster_tpl<Cfg>::find_circuit(circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits, unsigned & idx) {
+    if (!m_circuit_manager)
+        m_circuit_manager = &m();
+    if (k == MUL_CIRCUIT) {
+        // multiplication is commutative, use a canonical order of the operands.
+        for (unsigned i = 0; i < sz; i++) {
+            if (a_bits[i] == b_bits[i])
+                continue;
+            if (a_bits[i]->get_id() > b_bits[i]->get_id())
+                std::swap(a_bits, b_bits);
+            break;
+        }
+    }
+    circuit c;
+    c.m_kind = k;
+    c.m_sz   = sz;
+    c.m_args = m_circuit_bits.size();
+    c.m_outs = UINT_MAX;
+    unsigned h = hash_u_u(k, sz);
+    for (unsigned i = 0; i < sz; i++)
+        h = combine_hash(h, hash_u_u(a_bits[i]->get_id(), b_bits[i]->get_id()));
+    c.m_hash = h;
+    push_circuit_bits(sz, a_bits);
+    push_circuit_bits(sz, b_bits);
+    m_circuits.push_back(c);
+    unsigned probe = m_circuits.size() - 1;
+    if (m_circuit_table.find(probe, idx)) {
+        for (unsigned i = c.m_args; i < m_circuit_bits.size(); i++)
+            m_circuit_manager->dec_ref(m_circuit_bits[i]);
+        m_circuit_bits.shrink(c.m_args);
+        m_circuits.pop_back();
+        m_num_circuit_hits++;
+        return true;
+    }
+    idx = probe;
+    return false;
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::insert_circuit(unsigned idx, expr_ref_vector const & out1, expr_ref_vector const * out2) {
+    circuit & c = m_circuits[idx];
+    c.m_outs = m_circuit_bits.size();
+    SASSERT(out1.size() == c.m_sz);
+    push_circuit_bits(c.m_sz, out1.c_ptr());
+    if (out2) {
+        SASSERT(out2->size() == c.m_sz);
+        push_circuit_bits(c.m_sz, out2->c_ptr());
+    }
+    m_circuit_table.insert(idx);
+}
+
+/**
+   \brief Retrieve the i-th output of the cached circuit at idx.
+*/
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::get_circuit(unsigned idx, unsigned i, expr_ref_vector & out_bits) {
+    circuit const & c = m_circuits[idx];
+    SASSERT(c.m_outs != UINT_MAX);
+    unsigned offset = c.m_outs + i * c.m_sz;
+    for (unsigned j = 0; j < c.m_sz; j++)
+        out_bits.push_back(m_circuit_bits[offset + j]);
+}
+
 template<typename Cfg>
 void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
+    unsigned idx;
+    if (!m_use_circuit_cache || is_numeral(sz, a_bits) || is_numeral(sz, b_bits)) {
+        mk_multiplier_core(sz, a_bits, b_bits, out_bits);
+    }
+    else if (find_circuit(MUL_CIRCUIT, sz, a_bits, b_bits, idx)) {
+        out_bits.reset();
+        get_circuit(idx, 0, out_bits);
+    }
+    else {
+        mk_multiplier_core(sz, a_bits, b_bits, out_bits);
+        insert_circuit(idx, out_bits, nullptr);
+    }
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_multiplier_core(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
     SASSERT(sz > 0);
     numeral n_a, n_b;
     out_bits.reset();
@@ -450,6 +565,24 @@ void bit_blaster_tpl<Cfg>::mk_smul_no_underflow(unsigned sz, expr * const * a_bi
 
 template<typename Cfg>
 void bit_blaster_tpl<Cfg>::mk_udiv_urem(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits) {
+    unsigned idx;
+    if (!m_use_circuit_cache) {
+        mk_udiv_urem_core(sz, a_bits, b_bits, q_bits, r_bits);
+    }
+    else if (find_circuit(UDIV_UREM_CIRCUIT, sz, a_bits, b_bits, idx)) {
+        q_bits.reset();
+        r_bits.reset();
+        get_circuit(idx, 0, q_bits);
+        get_circuit(idx, 1, r_bits);
+    }
+    else {
+        mk_udiv_urem_core(sz, a_bits, b_bits, q_bits, r_bits);
+        insert_circuit(idx, q_bits, &r_bits);
+    }
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_udiv_urem_core(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits) {
     SASSERT(sz > 0);
 
     // p is the residual of each stage of the division.
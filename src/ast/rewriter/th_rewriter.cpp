@@ -16,6 +16,7 @@ Author:
 Notes:
 
 --*/
+#include "util/gparams.h"
 #include "params/rewriter_params.hpp"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/rewriter/bool_rewriter.h"
@@ -35,6 +36,8 @@ Notes:
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/well_sorted.h"
+#include "ast/expr_lru_cache.h"
+#include <sstream>
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -55,6 +58,8 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     bool                m_pull_cheap_ite;
     bool                m_flat;
     bool                m_cache_all;
+    unsigned            m_persistent_cache;
+    bool                m_scratch;
     bool                m_push_ite_arith;
     bool                m_push_ite_bv;
     bool                m_ignore_patterns_on_ground_qbody;
@@ -73,6 +78,8 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_max_steps      = p.max_steps();
         m_pull_cheap_ite = p.pull_cheap_ite();
         m_cache_all      = p.cache_all();
+        m_persistent_cache = p.persistent_cache();
+        m_scratch        = p.scratch();
         m_push_ite_arith = p.push_ite_arith();
         m_push_ite_bv    = p.push_ite_bv();
         m_ignore_patterns_on_ground_qbody = p.ignore_patterns_on_ground_qbody();
@@ -805,8 +812,37 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
 };
 
 th_rewriter::th_rewriter(ast_manager & m, params_ref const & p):
-    m_params(p) {
+    m_params(p),
+    m_has_solver(false),
+    m_cache_hit(false) {
     m_imp = alloc(imp, m, p);
+    updt_persistent_cache();
+}
+
+/**
+   \brief The results in the persistent cache of the manager are tagged with
+   a hash of the settings, so rewriters with different settings do not share results.
+   The settings are the parameters of the rewriter on top of the global rewriter module.
+*/
+void th_rewriter::updt_persistent_cache() {
+    params_ref p = gparams::get_module("rewriter");
+    p.copy(m_params);
+    std::ostringstream strm;
+    p.display(strm);
+    std::string s = strm.str();
+    m_params_hash = string_hash(s.c_str(), static_cast<unsigned>(s.length()), 17);
+    unsigned capacity = m_imp->cfg().m_persistent_cache;
+    if (capacity > 0)
+        m().rewrite_cache().set_capacity(capacity);
+}
+
+/**
+   \brief Results are kept across calls only if they do not depend on a substitution or
+   a solver, and no proofs are produced.
+*/
+bool th_rewriter::use_persistent_cache() const {
+    th_rewriter_cfg const & cfg = m_imp->cfg();
+    return cfg.m_persistent_cache > 0 && cfg.m_subst == nullptr && !m_has_solver && !m().proofs_enabled();
 }
 
 ast_manager & th_rewriter::m() const {
@@ -816,6 +852,7 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params = p;
     m_imp->cfg().updt_params(p);
+    updt_persistent_cache();
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -835,7 +872,12 @@ unsigned th_rewriter::get_cache_size() const {
 }
 
 unsigned th_rewriter::get_num_steps() const {
-    return m_imp->get_num_steps();
+    return m_cache_hit ? 0 : m_imp->get_num_steps();
+}
+
+void th_rewriter::collect_statistics(statistics & st) const {
+    if (m().has_rewrite_cache())
+        m().rewrite_cache().collect_statistics(st);
 }
 
 
@@ -852,15 +894,45 @@ void th_rewriter::reset() {
 
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());
-    m_imp->operator()(term, result);
+    operator()(term, result);
     term = std::move(result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
+    m_cache_hit = false;
+    // with rewriter.scratch the intermediate terms of this call, including
+    // the ones held by the rewriter cache, are released when the call ends.
+    bool scratch = m_imp->cfg().m_scratch;
+    ast_manager::scratch_scope _scratch(m(), scratch);
+    if (!use_persistent_cache()) {
+        m_imp->operator()(t, result);
+        if (scratch)
+            m_imp->reset();
+        return;
+    }
+    expr_lru_cache & cache = m().rewrite_cache();
+    expr * r = cache.find(t, m_params_hash);
+    if (r) {
+        m_cache_hit = true;
+        result = r;
+        return;
+    }
+    expr_ref _t(t, m()); // result may be the only reference to t
     m_imp->operator()(t, result);
+    // a canceled rewrite may return a partial result
+    if (m().inc())
+        cache.insert(t, m_params_hash, result);
+    if (scratch)
+        m_imp->reset();
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
+    if (use_persistent_cache()) {
+        operator()(t, result);
+        result_pr = nullptr;
+        return;
+    }
+    m_cache_hit = false;
     m_imp->operator()(t, result, result_pr);
 }
 
@@ -889,6 +961,7 @@ expr_ref th_rewriter::mk_app(func_decl* f, unsigned num_args, expr* const* args)
 }
 
 void th_rewriter::set_solver(expr_solver* solver) {
+    m_has_solver = solver != nullptr;
     m_imp->set_solver(solver);
 }
 
@@ -21,6 +21,7 @@ Notes:
 #include "ast/ast.h"
 #include "ast/rewriter/rewriter_types.h"
 #include "util/params.h"
+#include "util/statistics.h"
 
 class expr_substitution;
 
@@ -30,6 +31,12 @@ class th_rewriter {
     struct     imp;
     imp *      m_imp;
     params_ref m_params;
+    unsigned   m_params_hash;    // tag of the results stored in the persistent cache of the manager
+    bool       m_has_solver;
+    bool       m_cache_hit;      // the last result was found in the persistent cache
+
+    void updt_persistent_cache();
+    bool use_persistent_cache() const;
 public:
     th_rewriter(ast_manager & m, params_ref const & p = params_ref());
     ~th_rewriter();
@@ -58,6 +65,8 @@ public:
     void cleanup();
     void reset();
 
+    void collect_statistics(statistics & st) const;
+
     void set_substitution(expr_substitution * s);
     
     // Dependency tracking is very coarse. 
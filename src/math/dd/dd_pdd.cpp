@@ -26,6 +26,7 @@ namespace dd {
     pdd_manager::pdd_manager(unsigned num_vars, semantics s) {
         m_spare_entry = nullptr;
         m_max_num_nodes = 1 << 24; // up to 16M nodes
+        m_op_stamp = 0;
         m_mark_level = 0;
         m_dmark_level = 0;
         m_disable_gc = false;
@@ -93,6 +94,28 @@ namespace dd {
         m_op_cache.reset();
     }
 
+    void pdd_manager::new_round(unsigned max_entries) {
+        if (m_op_cache.size() > max_entries) {
+            ptr_vector<op_entry> to_delete, to_keep;
+            for (auto* e : m_op_cache) {
+                if (e->m_result != null_pdd && e->m_stamp != m_op_stamp) 
+                    to_delete.push_back(e);
+                else 
+                    to_keep.push_back(e);
+            }
+            m_op_cache.reset();
+            for (op_entry* e : to_delete) 
+                m_alloc.deallocate(sizeof(*e), e);
+            for (op_entry* e : to_keep) {
+                if (to_keep.size() > max_entries && e->m_result != null_pdd) 
+                    m_alloc.deallocate(sizeof(*e), e);
+                else
+                    m_op_cache.insert(e);
+            }
+        }
+        ++m_op_stamp;
+    }
+
     pdd pdd_manager::add(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_add_op), this); }
     pdd pdd_manager::sub(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_sub_op), this); }
     pdd pdd_manager::mul(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_mul_op), this); }
@@ -143,6 +166,7 @@ namespace dd {
     bool pdd_manager::check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c) {
         if (e1 != e2) {
             SASSERT(e2->m_result != null_pdd);
+            e2->m_stamp = m_op_stamp;
             push_entry(e1);
             e1 = nullptr;
             return true;            
@@ -712,6 +736,7 @@ namespace dd {
             result = new (mem) op_entry(l, r, op);
         }
         result->m_result = null_pdd;
+        result->m_stamp = m_op_stamp;
         return result;
     }
 
@@ -118,13 +118,15 @@ namespace dd {
                 m_pdd1(l),
                 m_pdd2(r),
                 m_op(op),
-                m_result(0)
+                m_result(0),
+                m_stamp(0)
             {}
 
             PDD      m_pdd1;
             PDD      m_pdd2;
             PDD      m_op;
             PDD      m_result;
+            mutable unsigned m_stamp; // round in which the entry was last used
             unsigned hash() const { return mk_mix(m_pdd1, m_pdd2, m_op); }
         };
 
@@ -159,6 +161,7 @@ namespace dd {
         bool                       m_disable_gc;
         bool                       m_is_new_node;
         unsigned                   m_max_num_nodes;
+        unsigned                   m_op_stamp;
         semantics                  m_semantics;
         unsigned_vector            m_free_vars;
         unsigned_vector            m_free_values;
@@ -260,6 +263,15 @@ namespace dd {
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n) { m_max_num_nodes = n; }
         unsigned_vector const& get_level2var() const { return m_level2var; }
+        unsigned num_nodes() const { return m_nodes.size(); }
+        unsigned op_cache_size() const { return m_op_cache.size(); }
+
+        /**
+           \brief start a new round of operations that keeps the nodes and the operation cache.
+           If the cache holds more than max_entries, entries not used in the last round are evicted,
+           and if that is not enough, the cache is emptied.
+         */
+        void new_round(unsigned max_entries);
 
         pdd mk_var(unsigned i);
         pdd mk_val(rational const& r);
@@ -31,9 +31,6 @@ class bound_analyzer_on_row {
     const C&                           m_row;
     B &                                m_bp;
     unsigned                           m_row_index;
-    int                                m_column_of_u; // index of an unlimited from above monoid
-    // -1 means that such a value is not found, -2 means that at least two of such monoids were found
-    int                                m_column_of_l; // index of an unlimited from below monoid
     impq                               m_rs;
 
 public :
@@ -48,8 +45,6 @@ public :
         m_row(it),
         m_bp(bp),
         m_row_index(row_or_term_index),
-        m_column_of_u(-1),
-        m_column_of_l(-1),
         m_rs(rs)
     {}
 
@@ -65,26 +60,63 @@ public :
 
 private:
 
+    // activities of the row: the sums of the minimal and maximal values of the monoids
+    // over the monoids that are bounded, the number of unbounded monoids, and
+    // the number of strict bounds used in the sums
+    struct activity {
+        mpq      m_sum;
+        unsigned m_num_inf;
+        unsigned m_inf_column;  // the unbounded monoid if m_num_inf == 1
+        const mpq* m_inf_coeff;
+        unsigned m_num_strict;
+        activity(): m_num_inf(0), m_inf_column(UINT_MAX), m_inf_coeff(nullptr), m_num_strict(0) {}
+        void add_inf(unsigned j, const mpq& a) {
+            if (m_num_inf++ == 0) {
+                m_inf_column = j;
+                m_inf_coeff = &a;
+            }
+        }
+        void add(const mpq& a, const impq& b) {
+            m_sum += a * b.x;
+            if (!is_zero(b.y))
+                m_num_strict++;
+        }
+    };
+    activity m_min, m_max;
+
+    /**
+       \brief compute the minimal and maximal activities in one scan of the row
+       and derive all implied bounds from them. Each implied bound then costs a division.
+    */
     void analyze() {
         for (const auto & c : m_row) {
-            if ((m_column_of_l == -2) && (m_column_of_u == -2))
+            if (m_min.m_num_inf > 1 && m_max.m_num_inf > 1)
                 return;
-            analyze_bound_on_var_on_coeff(c.var(), c.coeff());
+            add_to_activities(c.var(), c.coeff());
         }
-        if (m_column_of_u >= 0)
+        if (m_max.m_num_inf == 1)
             limit_monoid_u_from_below();
-        else if (m_column_of_u == -1)
+        else if (m_max.m_num_inf == 0)
             limit_all_monoids_from_below();
 
-        if (m_column_of_l >= 0)
+        if (m_min.m_num_inf == 1)
             limit_monoid_l_from_above();
-        else if (m_column_of_l == -1)
+        else if (m_min.m_num_inf == 0)
             limit_all_monoids_from_above();
     }
 
-    bool bound_is_available(unsigned j, bool lower_bound) {
-        return (lower_bound && lower_bound_is_available(j)) ||
-            (!lower_bound && upper_bound_is_available(j));
+    void add_to_activities(unsigned j, const mpq& a) {
+        bool a_is_pos = is_pos(a);
+        bool has_lower = lower_bound_is_available(j);
+        bool has_upper = upper_bound_is_available(j);
+        if (a_is_pos ? has_lower : has_upper)
+            m_min.add(a, a_is_pos ? lb(j) : ub(j));
+        else
+            m_min.add_inf(j, a);
+        if (a_is_pos ? has_upper : has_lower)
+            m_max.add(a, a_is_pos ? ub(j) : lb(j));
+        else
+            m_max.add_inf(j, a);
     }
 
     bool upper_bound_is_available(unsigned j) const {
@@ -128,19 +160,6 @@ private:
         return lb(j).x;
     }
 
-    mpq monoid_max(const mpq & a, unsigned j) const {
-        return a * (is_pos(a) ? ub(j).x : lb(j).x);
-    }
-
-    mpq monoid_max(const mpq & a, unsigned j, bool & strict) const {
-        if (is_pos(a)) {
-            strict = !is_zero(ub(j).y);
-            return a * ub(j).x;
-        }
-        strict = !is_zero(lb(j).y);
-        return a * lb(j).x;
-    }
-
     const mpq & monoid_min_no_mult(bool a_is_pos, unsigned j, bool & strict) const {
         if (!a_is_pos) {
             strict = !is_zero(ub(j).y);
@@ -150,64 +169,38 @@ private:
         return lb(j).x;
     }
 
-    mpq monoid_min(const mpq & a, unsigned j, bool& strict) const {
-        if (is_neg(a)) {
-            strict = !is_zero(ub(j).y);
-            return a * ub(j).x;
-        }        
-        strict = !is_zero(lb(j).y);
-        return a * lb(j).x;
-    }
-
-    mpq monoid_min(const mpq & a, unsigned j) const {
-        return a * (is_neg(a) ? ub(j).x : lb(j).x);
-    }
-    
     mpq m_total, m_bound;
+    // the row is sum of monoids = -m_rs: every monoid is bounded from above
+    // by the rest minus the minimal activity of the other monoids
     void limit_all_monoids_from_above() {
-        int strict = 0;
-        m_total.reset();
-        lp_assert(is_zero(m_total));
-        for (const auto& p : m_row) {
-            bool str;
-            m_total -= monoid_min(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
-        }
-        
+        m_total = -m_rs.x;
+        m_total -= m_min.m_sum;
         for (const auto &p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
             m_bound = m_total;
             m_bound /= p.coeff();
             m_bound += monoid_min_no_mult(a_is_pos, p.var(), str);
+            bool astrict = m_min.m_num_strict - static_cast<unsigned>(str) > 0;
             if (a_is_pos) {
-                limit_j(p.var(), m_bound, true, false, strict - static_cast<int>(str) > 0);
+                limit_j(p.var(), m_bound, true, false, astrict);
             }
             else {
-                limit_j(p.var(), m_bound, false, true, strict - static_cast<int>(str) > 0);
+                limit_j(p.var(), m_bound, false, true, astrict);
             }
         }
     }
 
     void limit_all_monoids_from_below() {
-        int strict = 0;
-        m_total.reset();
-        lp_assert(is_zero(m_total));
-        for (const auto &p : m_row) {
-            bool str;
-            m_total -= monoid_max(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
-        }
-
+        m_total = -m_rs.x;
+        m_total -= m_max.m_sum;
         for (const auto& p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
             m_bound = m_total;
             m_bound /= p.coeff();
             m_bound += monoid_max_no_mult(a_is_pos, p.var(), str);
-            bool astrict = strict - static_cast<int>(str) > 0; 
+            bool astrict = m_max.m_num_strict - static_cast<unsigned>(str) > 0; 
             if (a_is_pos) {
                 limit_j(p.var(), m_bound, true, true, astrict);
             }
@@ -217,116 +210,42 @@ private:
         }
     }
 
-    
     void limit_monoid_u_from_below() {
-        // we are going to limit from below the monoid m_column_of_u,
+        // we are going to limit from below the monoid that is unbounded from above,
         // every other monoid is impossible to limit from below
-        mpq u_coeff;
-        unsigned j;
+        unsigned u = m_max.m_inf_column;
+        const mpq& u_coeff = *m_max.m_inf_coeff;
         m_bound = -m_rs.x;
-        bool strict = false;
-        for (const auto& p : m_row) {
-            j = p.var();
-            if (j == static_cast<unsigned>(m_column_of_u)) {
-                u_coeff = p.coeff();
-                continue;
-            }
-            bool str;
-            m_bound -= monoid_max(p.coeff(), j, str);
-            if (str)
-                strict = true;
-        }
-
+        m_bound -= m_max.m_sum;
         m_bound /= u_coeff;
-        
+        bool strict = m_max.m_num_strict > 0;
         if (u_coeff.is_pos()) {
-            limit_j(m_column_of_u, m_bound, true, true, strict);
+            limit_j(u, m_bound, true, true, strict);
         } else {
-            limit_j(m_column_of_u, m_bound, false, false, strict);
+            limit_j(u, m_bound, false, false, strict);
         }
     }
 
 
     void limit_monoid_l_from_above() {
-        // we are going to limit from above the monoid m_column_of_l,
+        // we are going to limit from above the monoid that is unbounded from below,
         // every other monoid is impossible to limit from above
-        mpq l_coeff;
-        unsigned j;
+        unsigned l = m_min.m_inf_column;
+        const mpq& l_coeff = *m_min.m_inf_coeff;
         m_bound = -m_rs.x;
-        bool strict = false;
-        for (const auto &p : m_row) {
-            j = p.var();
-            if (j == static_cast<unsigned>(m_column_of_l)) {
-                l_coeff = p.coeff();
-                continue;
-            }
-
-            bool str;
-            m_bound -= monoid_min(p.coeff(), j, str);
-            if (str)
-                strict = true;
-        }
+        m_bound -= m_min.m_sum;
         m_bound /= l_coeff;
+        bool strict = m_min.m_num_strict > 0;
         if (is_pos(l_coeff)) {
-            limit_j(m_column_of_l, m_bound, true, false, strict);
+            limit_j(l, m_bound, true, false, strict);
         } else {
-            limit_j(m_column_of_l, m_bound, false, true, strict);
+            limit_j(l, m_bound, false, true, strict);
         }
     }
     
-    // // it is the coefficient before the bounded column
-    // void provide_evidence(bool coeff_is_pos) {
-    //     /*
-    //     auto & be = m_ibounds.back();
-    //     bool lower_bound = be.m_lower_bound;
-    //     if (!coeff_is_pos)
-    //         lower_bound = !lower_bound;
-    //     auto it = m_row.clone();
-    //     mpq a; unsigned j;
-    //     while (it->next(a, j)) {
-    //         if (be.m_j == j) continue;
-    //         lp_assert(bound_is_available(j, is_neg(a) ? lower_bound : !lower_bound));
-    //         be.m_vector_of_bound_signatures.emplace_back(a, j, numeric_traits<impq>::
-    //                                                      is_neg(a)? lower_bound: !lower_bound);
-    //     }
-    //     delete it;
-    //     */
-    // }
-
     void limit_j(unsigned j, const mpq& u, bool coeff_before_j_is_pos, bool is_lower_bound, bool strict){
         m_bp.try_add_bound(u, j, is_lower_bound, coeff_before_j_is_pos, m_row_index, strict);
     }
-    
-    void advance_u(unsigned j) {
-        m_column_of_u = (m_column_of_u == -1) ? j : -2;
-    }
-    
-    void advance_l(unsigned j) {
-        m_column_of_l = (m_column_of_l == -1) ? j : -2;
-    }
-    
-    void analyze_bound_on_var_on_coeff(int j, const mpq &a) {
-        switch (m_bp.get_column_type(j)) {
-        case column_type::lower_bound:
-            if (numeric_traits<mpq>::is_pos(a))
-                advance_u(j);
-            else 
-                advance_l(j);
-            break;
-        case column_type::upper_bound:
-            if (numeric_traits<mpq>::is_neg(a))
-                advance_u(j);
-            else
-                advance_l(j);
-            break;
-        case column_type::free_column:
-            advance_u(j);
-            advance_l(j);
-            break;
-        default:
-            break;
-        }
-    }   
 };
 }
 
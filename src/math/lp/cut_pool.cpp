@@ -0,0 +1,202 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    cut_pool.cpp
+
+Abstract:
+
+    Pool of cuts produced by int_solver
+
+Author:
+    Lev Nachmanson (levnach)
+    Nikolaj Bjorner (nbjorner)
+
+Revision History:
+--*/
+
+#include <cmath>
+#include "math/lp/int_solver.h"
+#include "math/lp/lar_solver.h"
+#include "math/lp/cut_pool.h"
+
+namespace lp {
+
+    cut_pool::cut_pool(int_solver& lia):
+        lia(lia),
+        lra(lia.lra),
+        m_last_norm(0),
+        m_max_size(256),
+        m_max_age(64),
+        m_max_parallelism(0.99) {}
+
+    cut_pool::coeffs_t cut_pool::sorted_coeffs(lar_term const& t) {
+        coeffs_t r = t.coeffs_as_vector();
+        std::sort(r.begin(), r.end(), [](std::pair<mpq, unsigned> const& a, std::pair<mpq, unsigned> const& b) {
+                return a.second < b.second; });
+        return r;
+    }
+
+    unsigned cut_pool::hash(coeffs_t const& coeffs, mpq const& k, bool upper) {
+        unsigned h = combine_hash(k.hash(), upper ? 1 : 0);
+        for (auto const& p : coeffs)
+            h = combine_hash(h, combine_hash(p.first.hash(), p.second));
+        return h;
+    }
+
+    double cut_pool::norm(coeffs_t const& coeffs) {
+        double r = 0;
+        for (auto const& p : coeffs) {
+            double c = p.first.get_double();
+            r += c * c;
+        }
+        return std::sqrt(r);
+    }
+
+    double cut_pool::parallelism(coeffs_t const& a, double na, coeffs_t const& b, double nb) {
+        if (na == 0 || nb == 0)
+            return 0;
+        double dot = 0;
+        unsigned i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i].second < b[j].second)
+                ++i;
+            else if (a[i].second > b[j].second)
+                ++j;
+            else
+                dot += a[i++].first.get_double() * b[j++].first.get_double();
+        }
+        return std::abs(dot) / (na * nb);
+    }
+
+    bool cut_pool::is_valid(cut const& c) const {
+        unsigned n = lra.A_r().column_count();
+        for (auto const& p : c.m_coeffs)
+            if (p.second >= n)
+                return false;
+        auto const& cs = lra.constraints();
+        for (witness const& w : c.m_ex) {
+            if (!cs.valid_index(w.m_ci) || !cs.is_active(w.m_ci))
+                return false;
+            lar_base_constraint const& con = cs[w.m_ci];
+            if (con.column() != w.m_column || con.kind() != w.m_kind || con.rhs() != w.m_rhs)
+                return false;
+        }
+        return true;
+    }
+
+    double cut_pool::violation(coeffs_t const& coeffs, mpq const& k, bool upper) const {
+        impq v;
+        for (auto const& p : coeffs)
+            v += p.first * lia.get_value(p.second);
+        impq d = upper ? v - impq(k) : impq(k) - v;
+        if (!d.is_pos())
+            return 0;
+        // a violation by an infinitesimal only counts as a tiny violation
+        return d.x.is_pos() ? d.x.get_double() : 1e-9;
+    }
+
+    double cut_pool::efficacy(lar_term const& t, mpq const& k, bool upper) const {
+        coeffs_t coeffs = sorted_coeffs(t);
+        double n = norm(coeffs);
+        return n == 0 ? 0 : violation(coeffs, k, upper) / n;
+    }
+
+    void cut_pool::erase(unsigned i) {
+        m_cuts[i] = m_cuts.back();
+        m_cuts.pop_back();
+    }
+
+    void cut_pool::add(cut_family f, lar_term const& t, mpq const& k, bool upper, explanation const& ex) {
+        cut c;
+        c.m_coeffs = sorted_coeffs(t);
+        if (c.m_coeffs.empty())
+            return;
+        auto const& cs = lra.constraints();
+        for (auto const& e : ex) {
+            constraint_index ci = e.ci();
+            if (ci == null_ci || !cs.valid_index(ci) || !cs.is_active(ci))
+                return;
+            lar_base_constraint const& con = cs[ci];
+            c.m_ex.push_back({ ci, con.column(), con.kind(), con.rhs() });
+        }
+        c.m_k = k;
+        c.m_upper = upper;
+        c.m_family = f;
+        c.m_age = 0;
+        c.m_hash = hash(c.m_coeffs, k, upper);
+        c.m_norm = norm(c.m_coeffs);
+        for (cut& d : m_cuts) {
+            if (d.m_hash == c.m_hash && d.m_upper == upper && d.m_k == k && d.m_coeffs == c.m_coeffs) {
+                // the same cut with a possibly different justification
+                d.m_ex.swap(c.m_ex);
+                d.m_age = 0;
+                return;
+            }
+        }
+        if (m_cuts.size() >= m_max_size) {
+            unsigned oldest = 0;
+            for (unsigned i = 1; i < m_cuts.size(); ++i)
+                if (m_cuts[i].m_age > m_cuts[oldest].m_age)
+                    oldest = i;
+            erase(oldest);
+        }
+        m_cuts.push_back(c);
+    }
+
+    void cut_pool::pop(unsigned num_columns) {
+        for (unsigned i = m_cuts.size(); i-- > 0; ) {
+            for (auto const& p : m_cuts[i].m_coeffs) {
+                if (p.second >= num_columns) {
+                    erase(i);
+                    break;
+                }
+            }
+        }
+        m_last.reset();
+    }
+
+    lia_move cut_pool::separate() {
+        int best = -1;
+        double best_efficacy = 0;
+        for (unsigned i = m_cuts.size(); i-- > 0; ) {
+            cut& c = m_cuts[i];
+            if (++c.m_age > m_max_age || !is_valid(c)) {
+                // erase moves the last cut, which may be the best one, to position i
+                if (best + 1 == static_cast<int>(m_cuts.size()))
+                    best = i;
+                erase(i);
+                continue;
+            }
+            double v = violation(c.m_coeffs, c.m_k, c.m_upper);
+            if (v == 0 || c.m_norm == 0)
+                continue;
+            if (!m_last.empty() && parallelism(c.m_coeffs, c.m_norm, m_last, m_last_norm) > m_max_parallelism)
+                continue;
+            double e = v / c.m_norm;
+            if (e > best_efficacy) {
+                best_efficacy = e;
+                best = i;
+            }
+        }
+        if (best == -1)
+            return lia_move::undef;
+        cut& c = m_cuts[best];
+        c.m_age = 0;
+        lia.m_t.clear();
+        for (auto const& p : c.m_coeffs)
+            lia.m_t.add_monomial(p.first, p.second);
+        lia.m_k = c.m_k;
+        lia.m_upper = c.m_upper;
+        lia.m_ex->clear();
+        for (witness const& w : c.m_ex)
+            lia.m_ex->push_back(w.m_ci);
+        m_last = c.m_coeffs;
+        m_last_norm = c.m_norm;
+        lia.settings().stats().m_cut_pool_hits++;
+        TRACE("cut_pool", lra.print_term(lia.m_t, tout << "pool cut: ") << (c.m_upper ? " <= " : " >= ") << c.m_k << "\n";);
+        SASSERT(lia.current_solution_is_inf_on_cut());
+        return lia_move::cut;
+    }
+}
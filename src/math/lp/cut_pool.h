@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    cut_pool.h
+
+Abstract:
+
+    Pool of cuts produced by int_solver (Gomory, MIR and HNF cuts).
+
+    A cut t >= k (or t <= k) is implied by the tableau rows and by the bounds
+    in its explanation. The explanation is stored as (constraint, column, kind, bound)
+    witnesses, and a stored cut is reused only while each witness is still an
+    active constraint of the lar_solver.  Cuts that mention columns removed by
+    a pop are dropped.
+
+    Before new cuts are generated, int_solver asks the pool to separate the current
+    solution. Violated cuts are scored by efficacy, the violation divided by the
+    Euclidean norm of the cut, and cuts that are nearly parallel to the previously
+    separated cut are skipped.  Cuts that stay unused age and are evicted.
+
+Author:
+    Lev Nachmanson (levnach)
+    Nikolaj Bjorner (nbjorner)
+
+Revision History:
+--*/
+#pragma once
+
+#include "math/lp/lia_move.h"
+#include "math/lp/lar_term.h"
+#include "math/lp/lar_constraints.h"
+#include "math/lp/explanation.h"
+
+namespace lp {
+    class int_solver;
+    class lar_solver;
+
+    enum class cut_family { gomory, mir, hnf };
+
+    class cut_pool {
+        typedef vector<std::pair<mpq, unsigned>> coeffs_t;
+
+        struct witness {
+            constraint_index m_ci;
+            unsigned         m_column;
+            lconstraint_kind m_kind;
+            mpq              m_rhs;
+        };
+
+        struct cut {
+            coeffs_t         m_coeffs;   // sorted by column
+            mpq              m_k;
+            bool             m_upper;
+            vector<witness>  m_ex;
+            cut_family       m_family;
+            unsigned         m_age;
+            unsigned         m_hash;
+            double           m_norm;
+        };
+
+        class int_solver&    lia;
+        class lar_solver&    lra;
+        vector<cut>          m_cuts;
+        coeffs_t             m_last;        // coefficients of the last separated cut
+        double               m_last_norm;
+        unsigned             m_max_size;
+        unsigned             m_max_age;
+        double               m_max_parallelism;
+
+        static unsigned hash(coeffs_t const& coeffs, mpq const& k, bool upper);
+        static double norm(coeffs_t const& coeffs);
+        static double parallelism(coeffs_t const& a, double na, coeffs_t const& b, double nb);
+        static coeffs_t sorted_coeffs(lar_term const& t);
+        bool is_valid(cut const& c) const;
+        double violation(coeffs_t const& coeffs, mpq const& k, bool upper) const;
+        void erase(unsigned i);
+
+    public:
+        cut_pool(int_solver& lia);
+
+        /**
+           \brief store the cut t >= k (t <= k if upper) with explanation ex.
+           The cut is not stored if some constraint of ex is not available for reuse.
+        */
+        void add(cut_family f, lar_term const& t, mpq const& k, bool upper, explanation const& ex);
+
+        /**
+           \brief efficacy of the cut on the current solution: the violation divided by the norm of t.
+           It is non-positive when the cut is satisfied.
+        */
+        double efficacy(lar_term const& t, mpq const& k, bool upper) const;
+
+        /**
+           \brief set the cut of int_solver to the most efficient stored cut violated by the current solution.
+           Returns lia_move::undef if there is no such cut.
+        */
+        lia_move separate();
+
+        /**
+           \brief remove the cuts that use columns at or above num_columns.
+        */
+        void pop(unsigned num_columns);
+
+        unsigned size() const { return m_cuts.size(); }
+        void reset() { m_cuts.reset(); m_last.reset(); }
+    };
+}
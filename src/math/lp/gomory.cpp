@@ -32,6 +32,7 @@ class create_cut {
     unsigned              m_inf_col; // a basis column which has to be an integer but has a non integral value
     const row_strip<mpq>& m_row;
     const int_solver&     lia;
+    mpq                   m_lambda; // the row is multiplied by m_lambda before the cut is derived
     mpq                   m_lcm_den;
     mpq                   m_f;
     mpq                   m_one_minus_f;
@@ -295,20 +296,18 @@ public:
         m_t.clear();
         mpq m_lcm_den(1);
         bool some_int_columns = false;
-        mpq m_f  = fractional_part(get_value(m_inf_col));
-        TRACE("gomory_cut_detail", tout << "m_f: " << m_f << ", ";
-              tout << "1 - m_f: " << 1 - m_f << ", get_value(m_inf_col).x - m_f = " << get_value(m_inf_col).x - m_f << "\n";);
-        lp_assert(m_f.is_pos() && (get_value(m_inf_col).x - m_f).is_int());  
+        TRACE("gomory_cut_detail", tout << "m_f: " << m_f << ", lambda: " << m_lambda << ", ";
+              tout << "1 - m_f: " << 1 - m_f << ", lambda*get_value(m_inf_col).x - m_f = " << m_lambda * get_value(m_inf_col).x - m_f << "\n";);
+        lp_assert(m_f.is_pos() && (m_lambda * get_value(m_inf_col).x - m_f).is_int());  
 
 #if SMALL_CUTS
         m_abs_max = 0;
         for (const auto & p : m_row) {
-            mpq t = abs(ceil(p.coeff()));
+            mpq t = abs(ceil(m_lambda * p.coeff()));
             if (t > m_abs_max) m_abs_max = t;
         }
         m_big_number = m_abs_max.expt(2);
 #endif
-        mpq one_min_m_f = 1 - m_f;
         for (const auto & p : m_row) {
             unsigned j = p.var();
             if (j == m_inf_col) {
@@ -324,12 +323,13 @@ public:
                     m_ex->push_back(column_upper_bound_constraint(j));
                     continue;
                 }
+                mpq a = m_lambda * p.coeff();
                 if (is_real(j)) {  
-                    real_case_in_gomory_cut(- p.coeff(), j);
+                    real_case_in_gomory_cut(- a, j);
                 } 
-                else if (!p.coeff().is_int()) {
+                else if (!a.is_int()) {
                     some_int_columns = true;
-                    m_fj = fractional_part(-p.coeff());
+                    m_fj = fractional_part(-a);
                     m_one_minus_fj = 1 - m_fj;
                     int_case_in_gomory_cut(j);
                 }
@@ -346,26 +346,27 @@ public:
         if (some_int_columns)
             adjust_term_and_k_for_some_ints_case_gomory();
         TRACE("gomory_cut_detail", dump_cut_and_constraints_as_smt_lemma(tout););
-        lp_assert(lia.current_solution_is_inf_on_cut());  // checks that indices are columns
+        lp_assert(lia.current_solution_is_inf_on_cut(m_t, m_k, false));
         TRACE("gomory_cut", print_linear_combination_of_column_indices_only(m_t.coeffs_as_vector(), tout << "gomory cut:"); tout << " <= " << m_k << std::endl;);
         return lia_move::cut;
     }
 
-    create_cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row, const int_solver& lia) :
+    create_cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row, const int_solver& lia, const mpq& lambda) :
         m_t(t),
         m_k(k),
         m_ex(ex),
         m_inf_col(basic_inf_int_j),
         m_row(row),
         lia(lia),
+        m_lambda(lambda),
         m_lcm_den(1),
-        m_f(fractional_part(get_value(basic_inf_int_j).x)),
+        m_f(fractional_part(lambda * get_value(basic_inf_int_j).x)),
         m_one_minus_f(1 - m_f) {}
     
 };
 
-lia_move gomory::cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row) {
-    create_cut cc(t, k, ex, basic_inf_int_j, row, lia);
+lia_move gomory::cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row, const mpq& lambda) {
+    create_cut cc(t, k, ex, basic_inf_int_j, row, lia, lambda);
     return cc.cut();
 }
 
@@ -417,7 +418,40 @@ lia_move gomory::operator()() {
     SASSERT(lra.row_is_correct(r));
     SASSERT(is_gomory_cut_target(row));
     lia.m_upper = false;
-    return cut(lia.m_t, lia.m_k, lia.m_ex, j, row);
+    lia_move result = cut(lia.m_t, lia.m_k, lia.m_ex, j, row, mpq(1));
+    if (result != lia_move::cut)
+        return result;
+    lia.m_cut_pool.add(cut_family::gomory, lia.m_t, lia.m_k, false, *lia.m_ex);
+    bool is_mir = false;
+    double best = lia.m_cut_pool.efficacy(lia.m_t, lia.m_k, false);
+    // mixed integer rounding: the cut of the row multiplied by a small integer
+    // is also valid and may cut deeper. The weaker candidates are kept in the pool.
+    for (unsigned lambda = 2; lambda <= 4; ++lambda) {
+        mpq l(lambda);
+        if ((l * lia.get_value(j).x).is_int())
+            continue;
+        lar_term t;
+        mpq k;
+        explanation ex;
+        if (cut(t, k, &ex, j, row, l) != lia_move::cut)
+            continue;
+        lia.m_cut_pool.add(cut_family::mir, t, k, false, ex);
+        double e = lia.m_cut_pool.efficacy(t, k, false);
+        if (e > best) {
+            TRACE("gomory_cut", tout << "mir cut with lambda " << lambda << " efficacy " << e << " > " << best << "\n";);
+            best = e;
+            is_mir = true;
+            lia.m_t = t;
+            lia.m_k = k;
+            lia.m_ex->clear();
+            lia.m_ex->add_expl(ex);
+        }
+    }
+    if (is_mir)
+        lia.settings().stats().m_mir_cuts++;
+    else
+        lia.settings().stats().m_gomory_cuts++;
+    return result;
 }
 
 
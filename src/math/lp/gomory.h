@@ -29,7 +29,7 @@ namespace lp {
         class lar_solver& lra;
         int find_basic_var();
         bool is_gomory_cut_target(const row_strip<mpq>& row);
-        lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row);
+        lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row, const mpq& lambda);
     public:
         gomory(int_solver& lia);
         ~gomory() {}
@@ -0,0 +1,278 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_bnb.cpp
+
+Abstract:
+
+    Parallel branch and bound for int_solver
+
+Author:
+    Lev Nachmanson (levnach)
+    Nikolaj Bjorner (nbjorner)
+
+Revision History:
+--*/
+
+#include "util/mutex.h"
+#include "util/z3_exception.h"
+#include "math/lp/int_solver.h"
+#include "math/lp/lar_solver.h"
+#include "math/lp/int_bnb.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <condition_variable>
+#endif
+
+namespace lp {
+
+    int_bnb::int_bnb(int_solver& lia):lia(lia), lra(lia.lra) {}
+
+    /**
+       \brief copy columns, terms and the current bounds of lra into dst.
+       Columns are created in the same order, so column indices coincide.
+    */
+    void int_bnb::copy(lar_solver& dst) const {
+        dst.settings().simplex_strategy() = lra.settings().simplex_strategy();
+        dst.settings().bound_propagation() = false;
+        unsigned n = lra.column_count();
+        for (unsigned j = 0; j < n; ++j) {
+            if (lra.column_corresponds_to_term(j)) {
+                unsigned ext = lra.local_to_external(j);
+                dst.add_term(lra.get_term(lra.column2tv(j)).coeffs_as_vector(), ext);
+            }
+            else {
+                dst.add_var(j, lra.column_is_int(j));
+            }
+            if (dst.column_count() != j + 1)
+                return;
+        }
+        for (unsigned j = 0; j < n; ++j) {
+            if (lia.has_lower(j)) {
+                impq const& b = lia.lower_bound(j);
+                dst.add_var_bound(j, b.y.is_zero() ? GE : GT, b.x);
+            }
+            if (lia.has_upper(j)) {
+                impq const& b = lia.upper_bound(j);
+                dst.add_var_bound(j, b.y.is_zero() ? LE : LT, b.x);
+            }
+        }
+    }
+
+    /**
+       \brief check that x satisfies the bounds and rows of lra and is integral on integer columns.
+    */
+    bool int_bnb::is_feasible(vector<impq> const& x) const {
+        if (x.size() != lra.column_count())
+            return false;
+        for (unsigned j = 0; j < x.size(); ++j) {
+            if (lia.column_is_int(j) && !x[j].is_int())
+                return false;
+            if (lia.has_lower(j) && x[j] < lia.lower_bound(j))
+                return false;
+            if (lia.has_upper(j) && x[j] > lia.upper_bound(j))
+                return false;
+        }
+        for (auto const& row : lra.A_r().m_rows) {
+            impq r;
+            for (auto const& c : row)
+                r += c.coeff() * x[c.var()];
+            if (!r.is_zero())
+                return false;
+        }
+        return true;
+    }
+
+    lia_move int_bnb::operator()() {
+        lp_settings& s = lia.settings();
+        if (!s.use_tableau())
+            return lia_move::undef;
+        s.stats().m_bnb_calls++;
+
+        mutex            mux;
+#ifndef SINGLE_THREAD
+        std::condition_variable cond;
+#endif
+        vector<node>     queue;
+        vector<impq>     solution;
+        atomic<bool>     done(false);
+        unsigned         error_code = 0;
+        std::string      ex_msg;
+        bool             has_exception = false;
+        unsigned         num_active = 0;
+        unsigned         num_nodes = 0;
+        unsigned         max_nodes = s.int_bnb_max_nodes();
+        queue.push_back(node());
+        queue.back().m_num_inf = UINT_MAX;
+
+        class bnb_limit : public lp_resource_limit {
+            atomic<bool>& m_done;
+        public:
+            bnb_limit(atomic<bool>& d): m_done(d) {}
+            bool get_cancel_flag() override { return m_done; }
+        };
+
+        // wake up workers waiting for nodes after the queue, the number of active nodes or done changed
+        auto notify = [&]() {
+#ifndef SINGLE_THREAD
+            cond.notify_all();
+#endif
+        };
+
+        auto stop = [&]() {
+            {
+                lock_guard lock(mux);
+                done = true;
+            }
+            notify();
+        };
+
+        // wait for a node and take the most promising one: fewest integer infeasible columns, then the deepest.
+        // Return false when the search is over: done is set, or the queue is empty and no node is being solved.
+        auto pop_node = [&](node& n) {
+#ifndef SINGLE_THREAD
+            std::unique_lock<std::mutex> lock(mux);
+            cond.wait(lock, [&]() { return done || !queue.empty() || num_active == 0; });
+#else
+            lock_guard lock(mux);
+#endif
+            if (queue.empty() || done)
+                return false;
+            unsigned best = 0;
+            for (unsigned i = 1; i < queue.size(); ++i) {
+                node const& a = queue[i], &b = queue[best];
+                if (a.m_num_inf < b.m_num_inf ||
+                    (a.m_num_inf == b.m_num_inf && a.m_branches.size() > b.m_branches.size()))
+                    best = i;
+            }
+            n = queue[best];
+            queue[best] = queue.back();
+            queue.pop_back();
+            ++num_active;
+            return true;
+        };
+
+        unsigned seed = s.random_next();
+        auto search = [&](unsigned id) {
+            bnb_limit lim(done);
+            lar_solver solver;
+            solver.settings().set_resource_limit(lim);
+            solver.settings().set_random_seed(seed + id);
+            copy(solver);
+            if (solver.column_count() != lra.column_count()) {
+                stop();
+                return;
+            }
+            node n;
+            while (!done) {
+                if (s.get_cancel_flag()) {
+                    stop();
+                    break;
+                }
+                if (!pop_node(n))
+                    break;
+                solver.push();
+                for (branch const& b : n.m_branches)
+                    solver.add_var_bound(b.m_j, b.m_kind, b.m_bound);
+                lp_status st = solver.find_feasible_solution();
+                unsigned num_inf = 0;
+                unsigned inf_j = UINT_MAX;
+                if (st == lp_status::OPTIMAL || st == lp_status::FEASIBLE) {
+                    for (unsigned j = 0; j < solver.column_count(); ++j) {
+                        if (solver.column_is_int(j) && !solver.get_column_value(j).is_int()) {
+                            ++num_inf;
+                            if (inf_j == UINT_MAX || (solver.is_base(j) && !solver.is_base(inf_j)))
+                                inf_j = j;
+                        }
+                    }
+                }
+                {
+                    lock_guard lock(mux);
+                    --num_active;
+                    ++num_nodes;
+                    if (st != lp_status::OPTIMAL && st != lp_status::FEASIBLE) {
+                        // infeasible or canceled: the node is closed
+                    }
+                    else if (num_inf == 0) {
+                        if (!done) {
+                            solution.reset();
+                            for (unsigned j = 0; j < solver.column_count(); ++j)
+                                solution.push_back(solver.get_column_value(j));
+                            done = true;
+                        }
+                    }
+                    else if (num_nodes + queue.size() < max_nodes) {
+                        impq const& v = solver.get_column_value(inf_j);
+                        node lo = n, hi = n;
+                        lo.m_branches.push_back({ inf_j, LE, floor(v.x) });
+                        hi.m_branches.push_back({ inf_j, GE, ceil(v.x) });
+                        lo.m_num_inf = hi.m_num_inf = num_inf;
+                        queue.push_back(lo);
+                        queue.push_back(hi);
+                    }
+                }
+                notify();
+                solver.pop(1);
+            }
+        };
+
+        // record the first exception of a worker and stop the others; it is rethrown after all workers joined
+        auto worker = [&](unsigned id) {
+            try {
+                search(id);
+            }
+            catch (z3_error & err) {
+                lock_guard lock(mux);
+                if (!has_exception) {
+                    has_exception = true;
+                    error_code = err.error_code();
+                }
+                done = true;
+            }
+            catch (z3_exception & ex) {
+                lock_guard lock(mux);
+                if (!has_exception) {
+                    has_exception = true;
+                    ex_msg = ex.msg();
+                }
+                done = true;
+            }
+            notify();
+        };
+
+        unsigned num_threads = std::max(1u, s.int_bnb_threads());
+#ifdef SINGLE_THREAD
+        num_threads = 1;
+#else
+        num_threads = std::min(num_threads, std::max(1u, (unsigned)std::thread::hardware_concurrency()));
+        vector<std::thread> threads;
+        for (unsigned i = 1; i < num_threads; ++i)
+            threads.push_back(std::thread([&, i]() { worker(i); }));
+#endif
+        worker(0);
+#ifndef SINGLE_THREAD
+        for (auto& t : threads)
+            t.join();
+#endif
+        s.stats().m_bnb_nodes += num_nodes;
+        if (has_exception) {
+            if (error_code != 0)
+                throw z3_error(error_code);
+            throw default_exception(std::move(ex_msg));
+        }
+        TRACE("int_bnb", tout << "nodes: " << num_nodes << " threads: " << num_threads << " solved: " << !solution.empty() << "\n";);
+        if (solution.empty() || !is_feasible(solution))
+            return lia_move::undef;
+        auto& rs = lia.lrac.m_r_solver;
+        for (unsigned j = 0; j < solution.size(); ++j) {
+            lia.lrac.m_r_x[j] = solution[j];
+            if (rs.inf_set_contains(j))
+                rs.remove_column_from_inf_set(j);
+        }
+        SASSERT(lra.ax_is_correct());
+        s.stats().m_bnb_success++;
+        return lia_move::sat;
+    }
+}
@@ -0,0 +1,55 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_bnb.h
+
+Abstract:
+
+    Parallel branch and bound for int_solver.
+
+    The current bounds and terms of the lar_solver are copied into one
+    lar_solver per worker thread. The workers take subproblems, sets of
+    additional branch bounds, from a shared queue ordered by the number of
+    integer infeasible columns of the parent relaxation, and stop as soon as
+    one of them finds an integral solution or the node budget is spent.
+    An integral solution satisfies all bounds and rows of the original lar_solver
+    and is copied back into it.
+
+Author:
+    Lev Nachmanson (levnach)
+    Nikolaj Bjorner (nbjorner)
+
+Revision History:
+--*/
+#pragma once
+
+#include "math/lp/lia_move.h"
+#include "math/lp/lp_types.h"
+#include "math/lp/numeric_pair.h"
+#include "util/vector.h"
+
+namespace lp {
+    class int_solver;
+    class lar_solver;
+    class int_bnb {
+        struct branch {
+            unsigned         m_j;
+            lconstraint_kind m_kind;
+            mpq              m_bound;
+        };
+        struct node {
+            vector<branch>   m_branches;
+            unsigned         m_num_inf;    // number of integer infeasible columns of the parent
+        };
+        class int_solver& lia;
+        class lar_solver& lra;
+
+        void copy(lar_solver& dst) const;
+        bool is_feasible(vector<impq> const& x) const;
+    public:
+        int_bnb(int_solver& lia);
+        lia_move operator()();
+    };
+}
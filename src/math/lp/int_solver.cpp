@@ -11,6 +11,7 @@
 #include "math/lp/gomory.h"
 #include "math/lp/int_branch.h"
 #include "math/lp/int_cube.h"
+#include "math/lp/int_bnb.h"
 
 namespace lp {
 
@@ -122,7 +123,9 @@ int_solver::int_solver(lar_solver& lar_slv) :
     m_patcher(*this),
     m_number_of_calls(0),
     m_hnf_cutter(*this),
-    m_hnf_cut_period(settings().hnf_cut_period()) {
+    m_hnf_cut_period(settings().hnf_cut_period()),
+    m_cut_pool(*this),
+    m_bnb_period(4) {
     lra.set_int_solver(this);
 }
 
@@ -158,8 +161,8 @@ lia_move int_solver::check(lp::explanation * e) {
     ++m_number_of_calls;
     if (r == lia_move::undef && m_patcher.should_apply()) r = m_patcher();
     if (r == lia_move::undef && should_find_cube()) r = int_cube(*this)();
-    if (r == lia_move::undef && should_hnf_cut()) r = hnf_cut();
-    if (r == lia_move::undef && should_gomory_cut()) r = gomory(*this)();
+    if (r == lia_move::undef) r = cut_round();
+    if (r == lia_move::undef && should_bnb()) r = bnb();
     if (r == lia_move::undef) r = int_branch(*this)();
     return r;
 }
@@ -195,14 +198,18 @@ bool int_solver::cut_indices_are_columns() const {
 
 bool int_solver::current_solution_is_inf_on_cut() const {
     SASSERT(cut_indices_are_columns());
+    return current_solution_is_inf_on_cut(m_t, m_k, m_upper);
+}
+
+bool int_solver::current_solution_is_inf_on_cut(lar_term const& t, mpq const& k, bool upper) const {
     const auto & x = lrac.m_r_x;
-    impq v = m_t.apply(x);
-    mpq sign = m_upper ? one_of_type<mpq>()  : -one_of_type<mpq>();
-    CTRACE("current_solution_is_inf_on_cut", v * sign <= impq(m_k) * sign,
-           tout << "m_upper = " << m_upper << std::endl;
-           tout << "v = " << v << ", k = " << m_k << std::endl;
+    impq v = t.apply(x);
+    mpq sign = upper ? one_of_type<mpq>()  : -one_of_type<mpq>();
+    CTRACE("current_solution_is_inf_on_cut", v * sign <= impq(k) * sign,
+           tout << "upper = " << upper << std::endl;
+           tout << "v = " << v << ", k = " << k << std::endl;
           );
-    return v * sign > impq(m_k) * sign;
+    return v * sign > impq(k) * sign;
 }
 
 bool int_solver::has_inf_int() const {
@@ -270,6 +277,10 @@ bool int_solver::should_gomory_cut() {
     return m_number_of_calls % settings().m_int_gomory_cut_period == 0;
 }
 
+bool int_solver::should_bnb() {
+    return settings().int_bnb_threads() > 0 && m_number_of_calls % m_bnb_period == 0;
+}
+
 bool int_solver::should_hnf_cut() {
     return settings().enable_hnf() && m_number_of_calls % m_hnf_cut_period == 0;
 }
@@ -282,6 +293,32 @@ lia_move int_solver::hnf_cut() {
     else {
         m_hnf_cut_period = settings().hnf_cut_period();
     }
+    if (r == lia_move::cut) 
+        m_cut_pool.add(cut_family::hnf, m_t, m_k, m_upper, *m_ex);
+    return r;
+}
+
+lia_move int_solver::bnb() {
+    lia_move r = int_bnb(*this)();
+    if (r == lia_move::undef) 
+        m_bnb_period *= 2;
+    else 
+        m_bnb_period = 4;
+    return r;
+}
+
+/**
+   \brief cuts are tried in rounds: stored cuts that cut off the current solution
+   are preferred over new HNF and Gomory/MIR cuts.
+*/
+lia_move int_solver::cut_round() {
+    bool hnf = should_hnf_cut();
+    bool gomory_cut = should_gomory_cut();
+    if (!hnf && !gomory_cut)
+        return lia_move::undef;
+    lia_move r = m_cut_pool.separate();
+    if (r == lia_move::undef && hnf) r = hnf_cut();
+    if (r == lia_move::undef && gomory_cut) r = gomory(*this)();
     return r;
 }
 
@@ -27,6 +27,7 @@ Revision History:
 #include "math/lp/int_gcd_test.h"
 #include "math/lp/lia_move.h"
 #include "math/lp/explanation.h"
+#include "math/lp/cut_pool.h"
 
 namespace lp {
 class lar_solver;
@@ -39,6 +40,8 @@ class int_solver {
     friend class int_branch;
     friend class int_gcd_test;
     friend class hnf_cutter;
+    friend class cut_pool;
+    friend class int_bnb;
 
     class patcher {
         int_solver&         lia;
@@ -68,6 +71,8 @@ class int_solver {
     bool                m_upper;           // we have a cut m_t*x <= k if m_upper is true nad m_t*x >= k otherwise
     hnf_cutter          m_hnf_cutter;
     unsigned            m_hnf_cut_period;
+    cut_pool            m_cut_pool;
+    unsigned            m_bnb_period;
 public:
     int_solver(lar_solver& lp);
     
@@ -99,6 +104,7 @@ private:
     bool should_find_cube();
     bool should_gomory_cut();
     bool should_hnf_cut();
+    bool should_bnb();
 
     lp_settings& settings();
     const lp_settings& settings() const;
@@ -114,6 +120,8 @@ public:
     constraint_index column_upper_bound_constraint(unsigned j) const;
     constraint_index column_lower_bound_constraint(unsigned j) const;
     bool current_solution_is_inf_on_cut() const;
+    bool current_solution_is_inf_on_cut(lar_term const& t, mpq const& k, bool upper) const;
+    void pop_cuts(unsigned num_columns) { m_cut_pool.pop(num_columns); }
 
     bool shift_var(unsigned j, unsigned range);
     std::ostream&  display_row_info(std::ostream & out, unsigned row_index) const;
@@ -126,6 +134,8 @@ public:
     bool all_columns_are_bounded() const;
     void find_feasible_solution();
     lia_move hnf_cut();
+    lia_move cut_round();
+    lia_move bnb();
     void patch_nbasic_column(unsigned j) { m_patcher.patch_nbasic_column(j); }
   };
 }
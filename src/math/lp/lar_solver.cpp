@@ -259,6 +259,8 @@ void lar_solver::pop(unsigned k) {
     m_crossed_bounds_column.pop(k);
     unsigned n = m_columns_to_ul_pairs.peek_size(k);
     m_var_register.shrink(n);
+    if (m_int_solver)
+        m_int_solver->pop_cuts(n);
     if (m_settings.use_tableau()) {
         pop_tableau();
     }
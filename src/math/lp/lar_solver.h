@@ -176,9 +176,12 @@ class lar_solver : public column_namer {
         lp_bound_propagator<T> & bp ) {
         
         if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation
-            || row_has_a_big_num(row_index))
+            || row_has_a_big_num(row_index)) {
+            m_settings.stats().m_bp_rows_skipped++;
             return;
+        }
         lp_assert(use_tableau());
+        m_settings.stats().m_bp_rows++;
         
         bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(A_r().m_rows[row_index],
                                                                                    null_ci,
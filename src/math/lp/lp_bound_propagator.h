@@ -147,6 +147,7 @@ public:
     
         if (!m_imp.bound_is_interesting(j, kind, v))
             return;
+        m_imp.lp().settings().stats().m_bp_bounds++;
         unsigned k; // index to ibounds
         if (is_low) {
             if (try_get_value(m_improved_lower_bounds, j, k)) {
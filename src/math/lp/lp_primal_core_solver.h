@@ -514,6 +514,73 @@ public:
     }
     
     
+    bool value_is_feasible(unsigned j, const X & v) const {
+        switch (this->m_column_types[j]) {
+        case column_type::free_column:
+            return true;
+        case column_type::lower_bound:
+            return !this->below_bound(v, this->m_lower_bounds[j]);
+        case column_type::upper_bound:
+            return !this->above_bound(v, this->m_upper_bounds[j]);
+        default:
+            return !this->below_bound(v, this->m_lower_bounds[j]) && !this->above_bound(v, this->m_upper_bounds[j]);
+        }
+    }
+
+    // Try to repair the infeasible basic column 'leaving' without a pivot by moving boxed non-basic
+    // columns of its row to their opposite bounds. A flip is taken only if it does not overshoot the
+    // violated bound of 'leaving' and keeps every other basic column of the flipped column feasible,
+    // so the total infeasibility decreases with each flip.
+    // Returns true if 'leaving' became feasible.
+    bool try_bound_flips(unsigned leaving) {
+        unsigned i = this->m_basis_heading[leaving];
+        const X& target = get_val_for_leaving(leaving);
+        bool grow = needs_to_grow(leaving);
+        unsigned flips = 0;
+        for (const row_cell<T>& rc : this->m_A.m_rows[i]) {
+            unsigned j = rc.var();
+            if (j == leaving || this->m_column_types[j] != column_type::boxed)
+                continue;
+            X delta;
+            if (this->x_is_at_lower_bound(j))
+                delta = this->m_upper_bounds[j] - this->m_x[j];
+            else if (this->x_is_at_upper_bound(j))
+                delta = this->m_lower_bounds[j] - this->m_x[j];
+            else
+                continue;
+            // the basic column of row i changes by -a_ij * delta
+            X change = -delta * rc.coeff();
+            X new_val = this->m_x[leaving] + change;
+            if (grow ? (!is_pos(change) || new_val > target) : (!is_neg(change) || new_val < target))
+                continue;
+            bool ok = true;
+            for (const auto & c : this->m_A.m_columns[j]) {
+                unsigned k = this->m_basis[c.var()];
+                if (k != leaving && !value_is_feasible(k, this->m_x[k] - delta * this->m_A.get_val(c))) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (!ok)
+                continue;
+            this->add_delta_to_x(j, delta);
+            for (const auto & c : this->m_A.m_columns[j]) {
+                unsigned k = this->m_basis[c.var()];
+                if (k != leaving)
+                    this->add_delta_to_x_and_track_feasibility(k, -delta * this->m_A.get_val(c));
+            }
+            this->m_x[leaving] = new_val;
+            ++flips;
+            if (new_val == target)
+                break;
+        }
+        this->m_settings.stats().m_bound_flips += flips;
+        if (flips == 0 || !this->column_is_feasible(leaving))
+            return false;
+        this->remove_column_from_inf_set(leaving);
+        return true;
+    }
+
     void one_iteration_tableau_rows() {
         int leaving = find_smallest_inf_column();
         if (leaving == -1) {
@@ -522,6 +589,11 @@ public:
         }
        
         SASSERT(this->column_is_base(leaving));
+        if (!m_bland_mode_tableau && this->m_settings.bound_flips() && try_bound_flips(leaving)) {
+            if (this->current_x_is_feasible())
+                this->set_status(lp_status::OPTIMAL);
+            return;
+        }
         
         if (!m_bland_mode_tableau) {
             if (m_left_basis_tableau.contains(leaving)) {
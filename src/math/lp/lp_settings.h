@@ -118,18 +118,30 @@ struct statistics {
     unsigned m_patches_success;
     unsigned m_hnf_cutter_calls;
     unsigned m_hnf_cuts;
+    unsigned m_gomory_cuts;
+    unsigned m_mir_cuts;
+    unsigned m_cut_pool_hits;
     unsigned m_nla_calls;
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
     unsigned m_cross_nested_forms;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
+    unsigned m_grobner_reuse;
     unsigned m_cheap_eqs;
+    unsigned m_bound_flips;
+    unsigned m_bnb_calls;
+    unsigned m_bnb_nodes;
+    unsigned m_bnb_success;
+    unsigned m_bp_rows;
+    unsigned m_bp_rows_skipped;
+    unsigned m_bp_bounds;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
         st.update("arith-factorizations", m_num_factorizations);
         st.update("arith-make-feasible", m_make_feasible);
+        st.update("arith-lp-iterations", m_total_iterations);
         st.update("arith-max-columns", m_max_cols);
         st.update("arith-max-rows", m_max_rows);
         st.update("arith-gcd-calls", m_gcd_calls);
@@ -139,12 +151,24 @@ struct statistics {
         st.update("arith-patches", m_patches);
         st.update("arith-patches-success", m_patches_success);
         st.update("arith-hnf-calls", m_hnf_cutter_calls);
+        st.update("arith-cuts-hnf", m_hnf_cuts);
+        st.update("arith-cuts-gomory", m_gomory_cuts);
+        st.update("arith-cuts-mir", m_mir_cuts);
+        st.update("arith-cuts-pool", m_cut_pool_hits);
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
+        st.update("arith-grobner-reuse", m_grobner_reuse);
         st.update("arith-cheap-eqs", m_cheap_eqs);
+        st.update("arith-bound-flips", m_bound_flips);
+        st.update("arith-bnb-calls", m_bnb_calls);
+        st.update("arith-bnb-nodes", m_bnb_nodes);
+        st.update("arith-bnb-success", m_bnb_success);
+        st.update("arith-bp-rows", m_bp_rows);
+        st.update("arith-bp-rows-skipped", m_bp_rows_skipped);
+        st.update("arith-bp-bounds", m_bp_bounds);
 
     }
 };
@@ -238,11 +262,20 @@ private:
     bool             m_enable_hnf;
     bool             m_print_external_var_name;
     bool             m_cheap_eqs;
+    bool             m_bound_flips;
+    unsigned         m_int_bnb_threads;
+    unsigned         m_int_bnb_max_nodes;
 public:
     bool print_external_var_name() const { return m_print_external_var_name; }
     bool& print_external_var_name() { return m_print_external_var_name; }
     bool cheap_eqs() const { return m_cheap_eqs;}
     bool& cheap_eqs() { return m_cheap_eqs;}
+    bool bound_flips() const { return m_bound_flips; }
+    bool& bound_flips() { return m_bound_flips; }
+    unsigned int_bnb_threads() const { return m_int_bnb_threads; }
+    unsigned& int_bnb_threads() { return m_int_bnb_threads; }
+    unsigned int_bnb_max_nodes() const { return m_int_bnb_max_nodes; }
+    unsigned& int_bnb_max_nodes() { return m_int_bnb_max_nodes; }
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
     void set_hnf_cut_period(unsigned period) { m_hnf_cut_period = period;  }
     unsigned random_next() { return m_rand(); }
@@ -307,7 +340,10 @@ public:
                     limit_on_rows_for_hnf_cutter(75),
                     limit_on_columns_for_hnf_cutter(150),
                     m_enable_hnf(true),
-                    m_print_external_var_name(false)
+                    m_print_external_var_name(false),
+                    m_bound_flips(false),
+                    m_int_bnb_threads(0),
+                    m_int_bnb_max_nodes(1000)
                     
     {}
 
@@ -1045,12 +1045,57 @@ new_lemma& new_lemma::operator|=(ineq const& ineq) {
 }
     
 
+static bool same_term(lp::lar_term const& a, lp::lar_term const& b) {
+    if (a.size() != b.size())
+        return false;
+    auto const& bc = b.coeffs<u_map<rational>>();
+    rational c;
+    for (auto const& p : a) 
+        if (!bc.find(p.column().index(), c) || c != p.coeff())
+            return false;
+    return true;
+}
+
+static void sorted_constraints(lp::explanation const& e, unsigned_vector& cs) {
+    cs.reset();
+    for (auto const& p : e)
+        cs.push_back(p.ci());
+    std::sort(cs.begin(), cs.end());
+}
+
+/**
+   \brief check if the lemmas have the same inequalities, in the same order, and the same explanation.
+*/
+static bool same_lemma(lemma const& a, lemma const& b) {
+    if (a.ineqs().size() != b.ineqs().size() || a.expl().size() != b.expl().size())
+        return false;
+    for (unsigned i = 0; i < a.ineqs().size(); ++i) {
+        ineq const& x = a.ineqs()[i], &y = b.ineqs()[i];
+        if (x.cmp() != y.cmp() || x.rs() != y.rs() || !same_term(x.term(), y.term()))
+            return false;
+    }
+    unsigned_vector ca, cb;
+    sorted_constraints(a.expl(), ca);
+    sorted_constraints(b.expl(), cb);
+    return ca == cb;
+}
+
 new_lemma::~new_lemma() {
     static int i = 0;
     (void)i;
     (void)name;
     // code for checking lemma can be added here
     TRACE("nla_solver", tout << name << " " << (++i) << "\n" << *this; );
+    // different lemma generators can produce the same lemma in a round
+    auto& lemmas = *c.m_lemma_vec;
+    for (unsigned k = 0; k + 1 < lemmas.size(); ++k) {
+        if (same_lemma(lemmas[k], lemmas.back())) {
+            TRACE("nla_solver", tout << "duplicate of lemma " << k << "\n";);
+            lemmas.pop_back();
+            c.m_stats.m_nla_duplicate_lemmas++;
+            break;
+        }
+    }
 }
 
 lemma& new_lemma::current() const {
@@ -1627,7 +1672,7 @@ void core::configure_grobner() {
     cfg.m_number_of_conflicts_to_report = m_nla_settings.grobner_number_of_conflicts_to_report();
     m_pdd_grobner.set(cfg);
     m_pdd_grobner.adjust_cfg();
-    m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
+    m_pdd_manager.set_max_num_nodes(m_nla_settings.grobner_max_nodes()); // or something proportional to the number of initial nodes.
 }
 
 std::ostream& core::diagnose_pdd_miss(std::ostream& out) {
@@ -1846,6 +1891,13 @@ void core::set_level2var_for_grobner() {
     for (unsigned j = 0; j < n; j++)
         l2v[j] = sorted_vars[j];
 
+    // the nodes and the operation cache of the previous round remain valid
+    // as long as the variable order is the same
+    if (l2v == m_pdd_manager.get_level2var() && m_pdd_manager.num_nodes() < m_nla_settings.grobner_max_nodes()) {
+        m_pdd_manager.new_round(m_nla_settings.grobner_cache_size());
+        lp_settings().stats().m_grobner_reuse++;
+        return;
+    }
     m_pdd_manager.reset(l2v);
 }
 
@@ -1899,6 +1951,7 @@ bool core::influences_nl_var(lpvar j) const {
 void core::collect_statistics(::statistics & st) {
     st.update("arith-nla-explanations", m_stats.m_nla_explanations);
     st.update("arith-nla-lemmas", m_stats.m_nla_lemmas);
+    st.update("arith-nla-duplicate-lemmas", m_stats.m_nla_duplicate_lemmas);
     st.update("arith-nra-calls", m_stats.m_nra_calls);    
 }
 
@@ -142,6 +142,7 @@ class core {
     struct stats {
         unsigned m_nla_explanations;
         unsigned m_nla_lemmas;
+        unsigned m_nla_duplicate_lemmas;
         unsigned m_nra_calls;
         stats() { reset(); }
         void reset() {
@@ -29,6 +29,8 @@ class nla_settings {
     unsigned m_grobner_number_of_conflicts_to_report;
     unsigned m_grobner_quota;
     unsigned m_grobner_frequency;
+    unsigned m_grobner_max_nodes;
+    unsigned m_grobner_cache_size;
     bool     m_run_nra;
     // expensive patching
     bool     m_expensive_patching;
@@ -44,6 +46,8 @@ public:
                      m_grobner_subs_fixed(false),
                      m_grobner_quota(0),
                      m_grobner_frequency(4),
+                     m_grobner_max_nodes(10000),
+                     m_grobner_cache_size(1 << 16),
                      m_run_nra(false),
                      m_expensive_patching(false)
     {}
@@ -97,6 +101,11 @@ public:
     unsigned & grobner_number_of_conflicts_to_report() { return m_grobner_number_of_conflicts_to_report; }
 
     unsigned& grobner_quota() { return m_grobner_quota; }
+
+    unsigned grobner_max_nodes() const { return m_grobner_max_nodes; }
+    unsigned& grobner_max_nodes() { return m_grobner_max_nodes; }
+    unsigned grobner_cache_size() const { return m_grobner_cache_size; }
+    unsigned& grobner_cache_size() { return m_grobner_cache_size; }
     
 };
 }
@@ -20,12 +20,59 @@ Revision History:
 #include "util/vector.h"
 #include <utility>
 #include <set>
+#include "util/checked_int64.h"
 #include "math/lp/static_matrix.h"
 namespace lp {
 // each assignment for this matrix should be issued only once!!!
 
+/**
+   \brief r <- r + a*b using checked 64-bit arithmetic.
+   It applies when the numerators and denominators of r, a, b are small (fit in an int).
+   Return false if the operands are not small or an intermediate result overflows;
+   r is unchanged in this case.
+*/
+inline bool small_addmul(mpq& r, mpq const& a, mpq const& b) {
+    if (!r.is_small() || !a.is_small() || !b.is_small())
+        return false;
+    typedef checked_int64<true> i64;
+    int64_t an = numerator(a).get_int64(), ad = denominator(a).get_int64();
+    int64_t bn = numerator(b).get_int64(), bd = denominator(b).get_int64();
+    // a*b in lowest terms; the factors are below 2^31, so the products do not overflow.
+    int64_t g1 = static_cast<int64_t>(u64_gcd(static_cast<uint64_t>(an < 0 ? -an : an), static_cast<uint64_t>(bd)));
+    int64_t g2 = static_cast<int64_t>(u64_gcd(static_cast<uint64_t>(bn < 0 ? -bn : bn), static_cast<uint64_t>(ad)));
+    int64_t pn = (an / g1) * (bn / g2);
+    int64_t pd = (ad / g2) * (bd / g1);
+    try {
+        if (r.is_int() && pd == 1) {
+            i64 n = i64(r.get_int64()) + i64(pn);
+            r = rational(n.get_int64(), rational::i64());
+            return true;
+        }
+        int64_t rn = numerator(r).get_int64(), rd = denominator(r).get_int64();
+        i64 n, d;
+        if (rd == pd) {
+            n = i64(rn) + i64(pn);
+            d = i64(rd);
+        }
+        else {
+            n = i64(rn) * i64(pd) + i64(pn) * i64(rd);
+            d = i64(rd) * i64(pd);
+        }
+        if (n.is_zero()) {
+            r.reset();
+            return true;
+        }
+        int64_t g = static_cast<int64_t>(u64_gcd(static_cast<uint64_t>(n.abs().get_int64()), static_cast<uint64_t>(d.get_int64())));
+        r.set_normalized(n.get_int64() / g, static_cast<uint64_t>(d.get_int64() / g));
+        return true;
+    }
+    catch (i64::overflow_exception &) {
+        return false;
+    }
+}
+
 inline void addmul(double& r, double a, double b) { r += a*b; }
-inline void addmul(mpq& r, mpq const& a, mpq const& b) { r.addmul(a, b); }
+inline void addmul(mpq& r, mpq const& a, mpq const& b) { if (!small_addmul(r, a, b)) r.addmul(a, b); }
 
 template <typename T, typename X>
 void  static_matrix<T, X>::init_row_columns(unsigned m, unsigned n) {
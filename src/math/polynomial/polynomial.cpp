@@ -1857,6 +1857,8 @@ namespace polynomial {
         unsigned_vector          m_degree2pos;
         bool                     m_use_sparse_gcd;
         bool                     m_use_prs_gcd;
+        unsigned                 m_mod_resultant_min_bits;
+        svector<uint64_t>        m_mod_primes;      // primes below 2^31 used by mod_resultant
 
         // Debugging method: check if the coefficients of p are in the numeral_manager.
         bool consistent_coeffs(polynomial const * p) {
@@ -2338,6 +2340,7 @@ namespace polynomial {
             inc_ref(m_unit_poly);
             m_use_sparse_gcd = true;
             m_use_prs_gcd = false;
+            m_mod_resultant_min_bits = 256;
         }
 
         imp(reslimit& lim, manager & w, unsynch_mpz_manager & m, monomial_manager * mm):
@@ -5398,6 +5401,202 @@ namespace polynomial {
                     Res(A, B) = (-1)^(m*n) * mul(Res(R, B), lc^(m - r - d * n))
         */
         void resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
+            if (!m().modular() && is_univariate(p) && is_univariate(q) && max_var(p) == x && max_var(q) == x) {
+                // Hadamard's bound: |Res(p, q, x)| <= |p|_2^deg(q) * |q|_2^deg(p),
+                // twice the bound fits in bound_bits bits.
+                uint64_t bound_bits = 1 + static_cast<uint64_t>(degree(q, x)) * norm2_bits(p) + static_cast<uint64_t>(degree(p, x)) * norm2_bits(q);
+                if (bound_bits >= m_mod_resultant_min_bits && bound_bits <= UINT_MAX) {
+                    mod_resultant(p, q, x, static_cast<unsigned>(bound_bits), result);
+                    return;
+                }
+            }
+            resultant_prs(p, q, x, result);
+        }
+
+        /**
+           \brief Upper bound on the number of bits of the Euclidean norm of p.
+        */
+        unsigned norm2_bits(polynomial const * p) {
+            scoped_numeral sq(m()), sum(m());
+            unsigned sz = p->size();
+            for (unsigned i = 0; i < sz; i++) {
+                m().mul(p->a(i), p->a(i), sq);
+                m().add(sum, sq, sum);
+            }
+            return m().m().bitsize(sum) / 2 + 1;
+        }
+
+        /**
+           \brief Store the coefficients of the univariate polynomial p modulo prime in cs, cs[i] is the coefficient of x^i.
+           Return false if the leading coefficient vanishes modulo prime.
+        */
+        bool univ_coeffs_mod(polynomial const * p, var x, numeral const & prime, svector<uint64_t> & cs) {
+            unsigned d = degree(p, x);
+            cs.reset();
+            cs.resize(d + 1, 0);
+            scoped_numeral r(m());
+            unsigned sz = p->size();
+            for (unsigned i = 0; i < sz; i++) {
+                m().m().mod(p->a(i), prime, r);
+                cs[p->m(i)->degree_of(x)] = m().m().get_uint64(r);
+            }
+            return cs[d] != 0;
+        }
+
+        static uint64_t pow_mod(uint64_t a, uint64_t e, uint64_t n) {
+            uint64_t r = 1;
+            a %= n;
+            while (e > 0) {
+                if (e & 1)
+                    r = (r * a) % n;
+                a = (a * a) % n;
+                e >>= 1;
+            }
+            return r;
+        }
+
+        /**
+           \brief Miller-Rabin test with the bases 2, 7 and 61, it is exact for odd n < 2^32.
+        */
+        static bool is_prime_31(uint64_t n) {
+            uint64_t d = n - 1;
+            unsigned s = 0;
+            while ((d & 1) == 0) {
+                d >>= 1;
+                ++s;
+            }
+            for (uint64_t a : { 2, 7, 61 }) {
+                if (a % n == 0)
+                    continue;
+                uint64_t x = pow_mod(a, d, n);
+                if (x == 1 || x == n - 1)
+                    continue;
+                bool composite = true;
+                for (unsigned i = 1; i < s && composite; ++i) {
+                    x = (x * x) % n;
+                    composite = x != n - 1;
+                }
+                if (composite)
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+           \brief Return the i-th largest prime below 2^31.
+           The products of two residues fit in 64 bits.
+        */
+        uint64_t mod_prime(unsigned i) {
+            while (m_mod_primes.size() <= i) {
+                uint64_t n = m_mod_primes.empty() ? (1ull << 31) - 1 : m_mod_primes.back() - 2;
+                while (!is_prime_31(n))
+                    n -= 2;
+                m_mod_primes.push_back(n);
+            }
+            return m_mod_primes[i];
+        }
+
+        static uint64_t inv_mod(uint64_t a, uint64_t prime) {
+            // a^(prime - 2) = a^-1 (mod prime)
+            return pow_mod(a, prime - 2, prime);
+        }
+
+        /**
+           \brief Resultant of the dense polynomials a and b over Zp using the Euclidean algorithm:
+           Res(A, B) = (-1)^(deg(A)*deg(B)) * lc(B)^(deg(A) - deg(R)) * Res(B, R) where R = A mod B.
+           The leading coefficients of a and b must not vanish. a and b are destroyed.
+        */
+        static uint64_t resultant_mod(svector<uint64_t> & a, svector<uint64_t> & b, uint64_t prime) {
+            uint64_t res = 1;
+            while (b.size() > 1) {
+                unsigned da = a.size() - 1, db = b.size() - 1;
+                uint64_t lc_b = b.back();
+                if (da >= db) {
+                    // a <- a mod b
+                    uint64_t inv = inv_mod(lc_b, prime);
+                    for (unsigned i = da + 1; i-- > db; ) {
+                        uint64_t c = (a[i] * inv) % prime;
+                        if (c == 0)
+                            continue;
+                        uint64_t nc = prime - c;
+                        uint64_t * ai = a.c_ptr() + (i - db);
+                        for (unsigned k = 0; k <= db; ++k)
+                            ai[k] = (ai[k] + nc * b[k]) % prime;
+                    }
+                    a.shrink(db);
+                }
+                while (!a.empty() && a.back() == 0)
+                    a.pop_back();
+                if (a.empty())
+                    return 0;
+                if ((da & 1) && (db & 1))
+                    res = (prime - res) % prime;
+                for (unsigned i = a.size() - 1; i < da; ++i)
+                    res = (res * lc_b) % prime;
+                a.swap(b);
+            }
+            // Res(a, c) = c^deg(a) for a constant c
+            for (unsigned i = 1; i < a.size(); ++i)
+                res = (res * b[0]) % prime;
+            return res;
+        }
+
+        /**
+           \brief Multi-modular resultant of univariate polynomials.
+
+           The resultant is computed modulo big primes that preserve the degrees of p and q,
+           so the Sylvester matrix of the images is the image of the Sylvester matrix.
+           The images are combined using the Chinese remainder theorem until the product of
+           the primes uses more than bound_bits bits.
+        */
+        void mod_resultant(polynomial const * p, polynomial const * q, var x, unsigned bound_bits, polynomial_ref & result) {
+            SASSERT(!m().modular());
+            TRACE("resultant", tout << "mod_resultant, bound bits: " << bound_bits << "\n";);
+            svector<uint64_t> a, b;
+            scoped_numeral big_prime(m());
+            scoped_numeral bound(m());
+            scoped_numeral r(m());
+            scoped_numeral k(m());
+            scoped_numeral tmp(m());
+            for (unsigned i = 0; ; i++) {
+                checkpoint();
+                uint64_t prime = mod_prime(i);
+                m().set(big_prime, prime);
+                if (!univ_coeffs_mod(p, x, big_prime, a) || !univ_coeffs_mod(q, x, big_prime, b)) {
+                    TRACE("resultant", tout << "bad prime " << prime << ", leading coefficient vanished\n";);
+                    continue;
+                }
+                uint64_t res = resultant_mod(a, b, prime);
+                if (m().is_zero(bound)) {
+                    m().set(r, res);
+                    m().set(bound, big_prime);
+                }
+                else {
+                    // r <- r + bound * ((res - r) * bound^-1 mod prime)
+                    m().m().mod(r, big_prime, tmp);
+                    uint64_t r_mod = m().m().get_uint64(tmp);
+                    m().m().mod(bound, big_prime, tmp);
+                    uint64_t inv = inv_mod(m().m().get_uint64(tmp), prime);
+                    m().set(k, ((res + prime - r_mod) % prime) * inv % prime);
+                    m().m().addmul(r, bound, k, r);
+                    m().m().mul(bound, big_prime, bound);
+                }
+                if (m().m().bitsize(bound) > bound_bits) {
+                    // use the symmetric representation
+                    m().m().div(bound, mpz(2), tmp);
+                    if (m().m().gt(r, tmp))
+                        m().m().sub(r, bound, r);
+                    result = mk_const(r);
+                    TRACE("resultant", tout << "mod_resultant: " << result << "\n";);
+                    return;
+                }
+            }
+        }
+
+        /**
+           \brief Resultant using the subresultant PRS described above resultant.
+        */
+        void resultant_prs(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
             polynomial_ref A(pm());
             polynomial_ref B(pm());
             A = const_cast<polynomial*>(p);
@@ -18,6 +18,7 @@ Notes:
 --*/
 #include "math/polynomial/polynomial_cache.h"
 #include "util/chashtable.h"
+#include "util/stopwatch.h"
 
 namespace polynomial {
 
@@ -85,8 +86,20 @@ namespace polynomial {
     typedef chashtable<psc_chain_entry*, psc_chain_entry::hash_proc, psc_chain_entry::eq_proc> psc_chain_cache;
     typedef chashtable<factor_entry*, factor_entry::hash_proc, factor_entry::eq_proc> factor_cache;
     
+    struct cache_stats {
+        unsigned m_psc_hits;
+        unsigned m_psc_misses;
+        unsigned m_factor_hits;
+        unsigned m_factor_misses;
+        double   m_psc_time;        // seconds spent computing psc-chains on misses
+        double   m_factor_time;     // seconds spent factoring on misses
+        cache_stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
     struct cache::imp { 
         manager &                m;
+        cache_stats              m_stats;
         polynomial_table         m_poly_table;
         psc_chain_cache          m_psc_chain_cache;
         factor_cache             m_factor_cache;
@@ -161,9 +174,15 @@ namespace polynomial {
                 for (unsigned i = 0; i < old_entry->m_result_sz; i++) {
                     S.push_back(old_entry->m_result[i]);
                 }
+                m_stats.m_psc_hits++;
             }
             else {
+                stopwatch sw;
+                sw.start();
                 m.psc_chain(p, q, x, S);
+                sw.stop();
+                m_stats.m_psc_misses++;
+                m_stats.m_psc_time += sw.get_seconds();
                 unsigned sz = S.size();
                 entry->m_result_sz = sz;
                 entry->m_result    = static_cast<polynomial**>(m_allocator.allocate(sizeof(polynomial*)*sz));
@@ -188,10 +207,16 @@ namespace polynomial {
                 for (unsigned i = 0; i < old_entry->m_result_sz; i++) {
                     distinct_factors.push_back(old_entry->m_result[i]);
                 }
+                m_stats.m_factor_hits++;
             }
             else {
                 factors fs(m);
+                stopwatch sw;
+                sw.start();
                 m.factor(p, fs);
+                sw.stop();
+                m_stats.m_factor_misses++;
+                m_stats.m_factor_time += sw.get_seconds();
                 unsigned sz = fs.distinct_factors();
                 entry->m_result_sz = sz;
                 entry->m_result    = static_cast<polynomial**>(m_allocator.allocate(sizeof(polynomial*)*sz));
@@ -230,7 +255,29 @@ namespace polynomial {
     
     void cache::reset() {
         manager & _m = m();
+        cache_stats st = m_imp->m_stats;
         dealloc(m_imp);
         m_imp = alloc(imp, _m);
+        m_imp->m_stats = st;
+    }
+
+    static double time_saved(unsigned hits, unsigned misses, double miss_time) {
+        return misses == 0 ? 0.0 : hits * (miss_time / misses);
+    }
+
+    void cache::collect_statistics(statistics & st) const {
+        cache_stats const & s = m_imp->m_stats;
+        st.update("nlsat psc cache hits", s.m_psc_hits);
+        st.update("nlsat psc cache misses", s.m_psc_misses);
+        st.update("nlsat psc time", s.m_psc_time);
+        st.update("nlsat psc time saved", time_saved(s.m_psc_hits, s.m_psc_misses, s.m_psc_time));
+        st.update("nlsat factor cache hits", s.m_factor_hits);
+        st.update("nlsat factor cache misses", s.m_factor_misses);
+        st.update("nlsat factor time", s.m_factor_time);
+        st.update("nlsat factor time saved", time_saved(s.m_factor_hits, s.m_factor_misses, s.m_factor_time));
+    }
+
+    void cache::reset_statistics() {
+        m_imp->m_stats.reset();
     }
 };
@@ -19,6 +19,7 @@ Notes:
 #pragma once
 
 #include "math/polynomial/polynomial.h"
+#include "util/statistics.h"
 
 namespace polynomial {
 
@@ -37,6 +38,13 @@ namespace polynomial {
         void psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector & S);
         void factor(polynomial const * p, polynomial_ref_vector & distinct_factors);
         void reset();
+        /**
+           \brief Report hits and misses of the psc-chain and factorization caches,
+           the time spent on misses and an estimate of the time saved by the hits.
+           The counters survive reset().
+        */
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
     };
 };
 
@@ -2228,6 +2228,7 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            m_cache.collect_statistics(st);
         }
 
         void reset_statistics() {
@@ -2236,6 +2237,7 @@ namespace nlsat {
             m_decisions              = 0;
             m_stages                 = 0;
             m_irrational_assignments = 0;
+            m_cache.reset_statistics();
         }
 
         // -----------------------
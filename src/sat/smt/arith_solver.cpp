@@ -43,6 +43,9 @@ namespace arith {
         lp().settings().report_frequency = lpar.arith_rep_freq();
         lp().settings().print_statistics = lpar.arith_print_stats();
         lp().settings().cheap_eqs() = lpar.arith_cheap_eqs();
+        lp().settings().bound_flips() = lpar.arith_bound_flips();
+        lp().settings().int_bnb_threads() = lpar.arith_bnb_threads();
+        lp().settings().int_bnb_max_nodes() = lpar.arith_bnb_max_nodes();
         lp().set_cut_strategy(get_config().m_arith_branch_cut_ratio);
         lp().settings().int_run_gcd_test() = get_config().m_arith_gcd_test;
         lp().settings().set_random_seed(get_config().m_random_seed);
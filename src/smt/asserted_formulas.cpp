@@ -353,6 +353,7 @@ void asserted_formulas::display_ll(std::ostream & out, ast_mark & pp_visited) co
 }
 
 void asserted_formulas::collect_statistics(statistics & st) const {
+    m_rewriter.collect_statistics(st);
 }
 
 
@@ -33,8 +33,14 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_phase_caching_on = p.phase_caching_on();
     m_phase_caching_off = p.phase_caching_off();
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
-    if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
+    if (m_restart_strategy > RS_EMA) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
+    m_restart_fast_glue_avg = p.restart_emafastglue();
+    m_restart_slow_glue_avg = p.restart_emaslowglue();
+    m_restart_margin = p.restart_margin();
+    m_lemma_gc_tiered = p.lemma_gc_tiered();
+    m_lemma_gc_core_glue = p.lemma_gc_core_glue();
+    m_lemma_gc_tier2_glue = p.lemma_gc_tier2_glue();
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
     m_theory_case_split = p.theory_case_split();
     m_theory_aware_branching = p.theory_aware_branching();
@@ -47,6 +53,8 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_share_size = p.threads_share_size();
+    m_threads_share_glue = p.threads_share_glue();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -113,6 +121,8 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_share_size);
+    DISPLAY_PARAM(m_threads_share_glue);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
@@ -136,6 +146,9 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_restart_adaptive);
     DISPLAY_PARAM(m_agility_factor);
     DISPLAY_PARAM(m_restart_agility_threshold);
+    DISPLAY_PARAM(m_restart_fast_glue_avg);
+    DISPLAY_PARAM(m_restart_slow_glue_avg);
+    DISPLAY_PARAM(m_restart_margin);
 
     DISPLAY_PARAM(m_lemma_gc_strategy);
     DISPLAY_PARAM(m_lemma_gc_half);
@@ -148,6 +161,9 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_new_clause_relevancy);
     DISPLAY_PARAM(m_old_clause_relevancy);
     DISPLAY_PARAM(m_inv_clause_decay);
+    DISPLAY_PARAM(m_lemma_gc_tiered);
+    DISPLAY_PARAM(m_lemma_gc_core_glue);
+    DISPLAY_PARAM(m_lemma_gc_tier2_glue);
 
     DISPLAY_PARAM(m_smtlib_dump_lemmas);
     DISPLAY_PARAM(m_logic);
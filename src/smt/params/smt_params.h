@@ -46,7 +46,8 @@ enum restart_strategy {
     RS_IN_OUT_GEOMETRIC,
     RS_LUBY,
     RS_FIXED,
-    RS_ARITHMETIC
+    RS_ARITHMETIC,
+    RS_EMA
 };
 
 enum lemma_gc_strategy {
@@ -105,6 +106,8 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads;
     unsigned         m_threads_max_conflicts;
     unsigned         m_threads_cube_frequency;
+    unsigned         m_threads_share_size;
+    unsigned         m_threads_share_glue;
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
@@ -150,6 +153,9 @@ struct smt_params : public preprocessor_params,
     bool             m_restart_adaptive;
     double           m_agility_factor;
     double           m_restart_agility_threshold;
+    double           m_restart_fast_glue_avg;
+    double           m_restart_slow_glue_avg;
+    double           m_restart_margin;
 
     // -----------------------------------
     //
@@ -167,6 +173,9 @@ struct smt_params : public preprocessor_params,
     unsigned          m_new_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     unsigned          m_old_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     double            m_inv_clause_decay;     //!< clause activity decay
+    bool              m_lemma_gc_tiered;      //!< glue based tiered lemma garbage collection.
+    unsigned          m_lemma_gc_core_glue;   //!< lemmas with glue up to this value are never deleted.
+    unsigned          m_lemma_gc_tier2_glue;  //!< lemmas with glue up to this value are kept while used.
 
     // -----------------------------------
     //
@@ -260,6 +269,8 @@ struct smt_params : public preprocessor_params,
         m_threads(1),
         m_threads_max_conflicts(UINT_MAX),
         m_threads_cube_frequency(2),
+        m_threads_share_size(8),
+        m_threads_share_glue(4),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
@@ -281,6 +292,9 @@ struct smt_params : public preprocessor_params,
         m_restart_adaptive(true),
         m_agility_factor(0.9999),
         m_restart_agility_threshold(0.18),
+        m_restart_fast_glue_avg(3e-2),
+        m_restart_slow_glue_avg(1e-5),
+        m_restart_margin(1.1),
         m_lemma_gc_strategy(lemma_gc_strategy::LGC_FIXED),
         m_lemma_gc_half(false),
         m_recent_lemmas_size(100),
@@ -292,6 +306,9 @@ struct smt_params : public preprocessor_params,
         m_new_clause_relevancy(45),
         m_old_clause_relevancy(6),
         m_inv_clause_decay(1),
+        m_lemma_gc_tiered(false),
+        m_lemma_gc_core_glue(2),
+        m_lemma_gc_tier2_glue(6),
         m_smtlib_dump_lemmas(false),
         m_logic(symbol::null),
         m_profile_res_sub(false),
@@ -28,6 +28,7 @@ void theory_bv_params::updt_params(params_ref const & _p) {
     m_bv_enable_int2bv2int = p.bv_enable_int2bv(); 
     m_bv_eq_axioms = p.bv_eq_axioms();
     m_bv_delay = p.bv_delay();
+    m_bv_lazy_blast = p.bv_lazy_blast();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << std::endl;
@@ -42,4 +43,5 @@ void theory_bv_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_bv_blast_max_size);
     DISPLAY_PARAM(m_bv_enable_int2bv2int);
     DISPLAY_PARAM(m_bv_delay);
+    DISPLAY_PARAM(m_bv_lazy_blast);
 }
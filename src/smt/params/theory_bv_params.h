@@ -36,6 +36,7 @@ struct theory_bv_params {
     bool         m_bv_enable_int2bv2int;
     bool         m_bv_watch_diseq;
     bool         m_bv_delay;
+    unsigned     m_bv_lazy_blast;
     theory_bv_params(params_ref const & p = params_ref()):
         m_bv_mode(bv_solver_id::BS_BLASTER),
         m_hi_div0(false),
@@ -46,7 +47,8 @@ struct theory_bv_params {
         m_bv_blast_max_size(INT_MAX),
         m_bv_enable_int2bv2int(true),
         m_bv_watch_diseq(false),
-        m_bv_delay(true) {
+        m_bv_delay(true),
+        m_bv_lazy_blast(0) {
         updt_params(p);
     }
     
@@ -67,7 +67,7 @@ namespace smt {
         static unsigned get_obj_size(unsigned num_lits, clause_kind k, bool has_atoms, bool has_del_eh, bool has_justification) {
             unsigned r = sizeof(clause) + sizeof(literal) * num_lits;
             if (smt::is_lemma(k)) 
-                r += sizeof(unsigned);
+                r += 2 * sizeof(unsigned); // activity and glue
             /* dvitek: Fix alignment issues on 64-bit platforms.  The
              * 'if' statement below probably isn't worthwhile since
              * I'm guessing the allocator is probably going to round
@@ -92,10 +92,18 @@ namespace smt {
             return reinterpret_cast<unsigned *>(m_lits + m_capacity);
         }
 
+        unsigned const * get_glue_addr() const {
+            return get_activity_addr() + 1;
+        }
+
+        unsigned * get_glue_addr() {
+            return get_activity_addr() + 1;
+        }
+
         clause_del_eh * const * get_del_eh_addr() const {
             unsigned const * addr = get_activity_addr();
             if (is_lemma())
-                addr ++;
+                addr += 2;
             /* dvitek: It would be better to use uintptr_t than
              * size_t, but we need to wait until c++11 support is
              * really available.
@@ -221,6 +229,31 @@ namespace smt {
             *(get_activity_addr()) = act;
         }
 
+        /**
+           \brief Glue (literal block distance) of a lemma: the number of distinct decision levels
+           of its literals. The least significant bit records whether the lemma was used
+           in conflict resolution since the last lemma garbage collection.
+        */
+        unsigned get_glue() const {
+            SASSERT(is_lemma());
+            return *(get_glue_addr()) >> 1;
+        }
+
+        void set_glue(unsigned glue) {
+            SASSERT(is_lemma());
+            *(get_glue_addr()) = (glue << 1) | (*(get_glue_addr()) & 1);
+        }
+
+        bool is_used() const {
+            SASSERT(is_lemma());
+            return (*(get_glue_addr()) & 1) != 0;
+        }
+
+        void set_used(bool f) {
+            SASSERT(is_lemma());
+            *(get_glue_addr()) = (*(get_glue_addr()) & ~1u) | (f ? 1u : 0u);
+        }
+
         clause_del_eh * get_del_eh() const {
             return m_has_del_eh ? *(get_del_eh_addr()) : nullptr;
         }
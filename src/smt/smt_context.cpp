@@ -69,6 +69,7 @@ namespace smt {
         m_is_auxiliary(false),
         m_par(nullptr),
         m_par_index(0),
+        m_glue_stamp(0),
         m_cg_table(m),
         m_is_diseq_tmp(nullptr),
         m_units_to_reassert(m),
@@ -134,61 +135,86 @@ namespace smt {
     }
 
     void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
-        ast_manager& dst_m = dst_ctx.get_manager();
-        ast_manager& src_m = src_ctx.get_manager();
-        src_ctx.pop_to_base_lvl();
+        copy_snapshot s(src_ctx.get_manager());
+        src_ctx.mk_copy_snapshot(s, override_base);
+        copy_prepare(src_ctx, dst_ctx);
+        dst_ctx.copy_formulas(s);
+    }
+
+    void context::mk_copy_snapshot(copy_snapshot& s, bool override_base) {
+        SASSERT(&s.m == &m);
+        pop_to_base_lvl();
 
-        if (!override_base && src_ctx.m_base_lvl > 0) {
+        if (!override_base && m_base_lvl > 0) {
             throw default_exception("Cloning contexts within a user-scope is not allowed");
         }
-        SASSERT(src_ctx.m_base_lvl == 0 || override_base);
+        SASSERT(m_base_lvl == 0 || override_base);
+
+        for (unsigned i = 0; i < m_asserted_formulas.get_num_formulas(); ++i) {
+            s.m_fmls.push_back(m_asserted_formulas.get_formula(i));
+            s.m_prs.push_back(m_asserted_formulas.get_formula_proof(i));
+        }
+
+        s.m_configured = m_setup.already_configured();
+        if (!s.m_configured) {
+            return;
+        }
+
+        for (unsigned i = 0; !m.proofs_enabled() && i < m_assigned_literals.size(); ++i) {
+            literal lit = m_assigned_literals[i];
+            bool_var_data const & d = get_bdata(lit.var());
+            if (d.is_theory_atom() && !m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) {
+                continue;
+            }
+            expr_ref fml(m);
+            literal2expr(lit, fml);
+            s.m_units.push_back(fml);
+        }
 
-        ast_translation tr(src_m, dst_m, false);
+        if (m_user_propagator) {
+            s.m_has_user_propagator = true;
+            for (unsigned i = 0; i < m_user_propagator->get_num_vars(); ++i) 
+                s.m_user_vars.push_back(m_user_propagator->get_expr(i));
+        }
+    }
 
+    void context::copy_prepare(context& src_ctx, context& dst_ctx) {
         dst_ctx.set_logic(src_ctx.m_setup.get_logic());
         dst_ctx.copy_plugins(src_ctx, dst_ctx);
+        src_ctx.m_asserted_formulas.get_macro_manager().copy_to(dst_ctx.m_asserted_formulas.get_macro_manager());
+    }
 
-        asserted_formulas& src_af = src_ctx.m_asserted_formulas;
-        asserted_formulas& dst_af = dst_ctx.m_asserted_formulas;
+    void context::copy_formulas(copy_snapshot const& s) {
+        ast_translation tr(s.m, m, false);
+        tr.freeze_from();
 
         // Copy asserted formulas.
-        for (unsigned i = 0; i < src_af.get_num_formulas(); ++i) {
-            expr_ref fml(dst_m);
-            proof_ref pr(dst_m);
-            proof* pr_src = src_af.get_formula_proof(i);
-            fml = tr(src_af.get_formula(i));
+        for (unsigned i = 0; i < s.m_fmls.size(); ++i) {
+            expr_ref fml(m);
+            proof_ref pr(m);
+            proof* pr_src = s.m_prs.get(i);
+            fml = tr(s.m_fmls.get(i));
             if (pr_src) {
                 pr = tr(pr_src);
             }
-            dst_af.assert_expr(fml, pr);
+            m_asserted_formulas.assert_expr(fml, pr);
         }
 
-        src_af.get_macro_manager().copy_to(dst_af.get_macro_manager());
-
-        if (!src_ctx.m_setup.already_configured()) {
+        if (!s.m_configured) {
             return;
         }
 
-        for (unsigned i = 0; !src_m.proofs_enabled() && i < src_ctx.m_assigned_literals.size(); ++i) {
-            literal lit = src_ctx.m_assigned_literals[i];
-            bool_var_data const & d = src_ctx.get_bdata(lit.var());
-            if (d.is_theory_atom() && !src_ctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) {
-                continue;
-            }
-            expr_ref fml0(src_m), fml1(dst_m);
-            src_ctx.literal2expr(lit, fml0);
-            fml1 = tr(fml0.get());
-            dst_ctx.assert_expr(fml1);
+        for (expr* e : s.m_units) {
+            expr_ref fml(tr(e), m);
+            assert_expr(fml);
         }
 
-        dst_ctx.setup_context(dst_ctx.m_fparams.m_auto_config);
-        dst_ctx.internalize_assertions();
+        setup_context(m_fparams.m_auto_config);
+        internalize_assertions();
         
-        dst_ctx.copy_user_propagator(src_ctx);
+        copy_user_propagator(s, tr);
 
-        TRACE("smt_context",
-              src_ctx.display(tout);
-              dst_ctx.display(tout););
+        TRACE("smt_context", display(tout););
     }
 
     context::~context() {
@@ -206,17 +232,14 @@ namespace smt {
         }
     }
 
-    void context::copy_user_propagator(context& src_ctx) {
-        if (!src_ctx.m_user_propagator) 
+    void context::copy_user_propagator(copy_snapshot const& s, ast_translation& tr) {
+        if (!s.m_has_user_propagator) 
             return;
-        ast_translation tr(src_ctx.m, m, false);
         auto* p = get_theory(m.mk_family_id("user_propagator"));
         m_user_propagator = reinterpret_cast<user_propagator*>(p);
         SASSERT(m_user_propagator);
-        for (unsigned i = 0; i < src_ctx.m_user_propagator->get_num_vars(); ++i) {
-            app* e = src_ctx.m_user_propagator->get_expr(i);
+        for (expr* e : s.m_user_vars) 
             m_user_propagator->add_expr(tr(e));
-        }
     }
 
     context * context::mk_fresh(symbol const * l, smt_params * p, params_ref const& pa) {
@@ -2716,6 +2739,8 @@ namespace smt {
     inline void context::del_inactive_lemmas() {
         if (m_fparams.m_lemma_gc_strategy == LGC_NONE)
             return;
+        else if (m_fparams.m_lemma_gc_tiered)
+            del_inactive_lemmas3();
         else if (m_fparams.m_lemma_gc_half)
             del_inactive_lemmas1();
         else
@@ -2831,6 +2856,117 @@ namespace smt {
         IF_VERBOSE(2, verbose_stream() << " :num-deleted-clauses " << num_del_cls << ")" << std::endl;);
     }
 
+    /**
+       \brief Glue based tiered version of del_inactive_lemmas.
+       Lemmas with glue at most m_lemma_gc_core_glue are never deleted.
+       Lemmas with glue at most m_lemma_gc_tier2_glue are deleted if they were not
+       used in conflict resolution since the previous garbage collection.
+       The remaining lemmas are deleted if their activity is below the median.
+       The m_recent_lemmas_size most recent lemmas are not deleted.
+    */
+    void context::del_inactive_lemmas3() {
+        unsigned sz            = m_lemmas.size();
+        unsigned start_at      = m_base_lvl == 0 ? 0 : m_base_scopes[m_base_lvl - 1].m_lemmas_lim;
+        SASSERT(start_at <= sz);
+        unsigned end_at        = start_at + m_fparams.m_recent_lemmas_size >= sz ? start_at : sz - m_fparams.m_recent_lemmas_size;
+        unsigned core_glue     = m_fparams.m_lemma_gc_core_glue;
+        unsigned tier2_glue    = std::max(core_glue, m_fparams.m_lemma_gc_tier2_glue);
+        IF_VERBOSE(2, verbose_stream() << "(smt.delete-inactive-lemmas"; verbose_stream().flush(););
+        unsigned_vector acts;
+        for (unsigned i = start_at; i < end_at; i++) {
+            clause * cls = m_lemmas[i];
+            if (!cls->deleted() && cls->get_glue() > tier2_glue) 
+                acts.push_back(cls->get_activity());
+        }
+        unsigned act_threshold = 0;
+        if (!acts.empty()) {
+            std::nth_element(acts.begin(), acts.begin() + acts.size() / 2, acts.end());
+            act_threshold = acts[acts.size() / 2];
+        }
+        unsigned j             = start_at;
+        unsigned num_del_cls   = 0;
+        for (unsigned i = start_at; i < sz; i++) {
+            clause * cls = m_lemmas[i];
+            if (can_delete(cls)) {
+                bool del = cls->deleted();
+                if (!del && i < end_at) {
+                    unsigned glue = cls->get_glue();
+                    if (glue <= core_glue) {
+                        // keep
+                    }
+                    else if (glue <= tier2_glue) {
+                        del = !cls->is_used();
+                        if (del) m_stats.m_num_del_tier2_lemmas++;
+                    }
+                    else {
+                        del = cls->get_activity() < act_threshold;
+                        if (del) m_stats.m_num_del_local_lemmas++;
+                    }
+                }
+                if (del) {
+                    TRACE("del_inactive_lemmas", tout << "deleting: "; display_clause(tout, cls); tout << ", glue: " <<
+                          cls->get_glue() << ", activity: " << cls->get_activity() << "\n";);
+                    del_clause(true, cls);
+                    num_del_cls++;
+                    continue;
+                }
+            }
+            cls->set_used(false);
+            if (m_fparams.m_clause_decay > 1) 
+                cls->set_activity(cls->get_activity() / m_fparams.m_clause_decay);
+            m_lemmas[j++] = cls;
+        }
+        m_lemmas.shrink(j);
+        IF_VERBOSE(2, verbose_stream() << " :num-deleted-clauses " << num_del_cls << ")" << std::endl;);
+    }
+
+    /**
+       \brief Return the number of distinct assignment levels of the given literals (glue).
+       Each unassigned literal counts as a separate level.
+    */
+    unsigned context::compute_glue(unsigned num_lits, literal const * lits) {
+        ++m_glue_stamp;
+        if (m_glue_stamp == 0) {
+            m_glue_marks.fill(0);
+            m_glue_stamp = 1;
+        }
+        unsigned glue = 0;
+        for (unsigned i = 0; i < num_lits; ++i) {
+            literal l = lits[i];
+            if (get_assignment(l) == l_undef) {
+                ++glue;
+                continue;
+            }
+            unsigned lvl = get_assign_level(l);
+            if (lvl >= m_glue_marks.size()) 
+                m_glue_marks.resize(lvl + 1, 0);
+            if (m_glue_marks[lvl] != m_glue_stamp) {
+                m_glue_marks[lvl] = m_glue_stamp;
+                ++glue;
+            }
+        }
+        return glue;
+    }
+
+    /**
+       \brief Lemma cls is used in conflict resolution. Mark it as used, and lower its glue
+       if the current assignment spans fewer levels.
+    */
+    void context::update_glue(clause * cls) {
+        SASSERT(cls->is_lemma());
+        cls->set_used(true);
+        unsigned glue = cls->get_glue();
+        if (glue <= m_fparams.m_lemma_gc_core_glue)
+            return;
+        unsigned new_glue = compute_glue(cls->get_num_literals(), cls->begin());
+        if (new_glue < glue) {
+            m_stats.m_num_glue_updates++;
+            cls->set_glue(new_glue);
+            if (new_glue <= m_fparams.m_lemma_gc_core_glue)
+                m_stats.m_num_core_lemmas++;
+        }
+    }
+
     /**
        \brief Return true if "cls" has more than (or equal to) k unassigned literals.
     */
@@ -3613,6 +3749,8 @@ namespace smt {
         m_agility                      = 0.0;
         m_luby_idx                     = 1;
         m_lemma_gc_threshold           = m_fparams.m_lemma_gc_initial;
+        m_fast_glue_avg                .set_alpha(m_fparams.m_restart_fast_glue_avg);
+        m_slow_glue_avg                .set_alpha(m_fparams.m_restart_slow_glue_avg);
         m_last_search_failure          = OK;
         m_unsat_proof                  = nullptr;
         m_unsat_core                   .reset();
@@ -3646,6 +3784,7 @@ namespace smt {
                 m_restart_threshold = static_cast<unsigned>(get_luby(m_luby_idx) * m_fparams.m_restart_initial);
                 break;
             case RS_FIXED:
+            case RS_EMA:
                 break;
             case RS_ARITHMETIC:
                 m_restart_threshold = static_cast<unsigned>(m_restart_threshold + m_fparams.m_restart_factor);
@@ -3748,6 +3887,9 @@ namespace smt {
                 pop_scope(m_scope_lvl - curr_lvl);
                 SASSERT(at_search_level());
             }
+            if (m_par && !inconsistent()) {
+                m_par->get_clauses(*this);
+            }
             for (theory* th : m_theory_set) {
                 if (!inconsistent()) th->restart_eh();
             }
@@ -3789,6 +3931,16 @@ namespace smt {
         }
     }
 
+    bool context::should_restart() const {
+        if (m_num_conflicts_since_restart <= m_restart_threshold || m_scope_lvl - m_base_lvl <= 2)
+            return false;
+        if (m_fparams.m_restart_strategy != RS_EMA)
+            return true;
+        return 
+            m_fast_glue_avg + m_search_lvl <= m_scope_lvl &&
+            m_fparams.m_restart_margin * m_slow_glue_avg <= m_fast_glue_avg;
+    }
+
     lbool context::bounded_search() {
         unsigned counter = 0;
 
@@ -3818,7 +3970,7 @@ namespace smt {
                     if (get_cancel_flag())
                         return l_undef;
 
-                    if (m_num_conflicts_since_restart > m_restart_threshold && m_scope_lvl - m_base_lvl > 2) {
+                    if (should_restart()) {
                         TRACE("search_bug", tout << "bounded-search return undef, inconsistent: " << inconsistent() << "\n";);
                         return l_undef; // restart
                     }
@@ -4181,7 +4333,17 @@ namespace smt {
                 }
             }
 #endif
-            mk_clause(num_lits, lits, js, CLS_LEARNED);
+            unsigned glue = UINT_MAX;
+            if (track_glue()) {
+                glue = compute_glue(num_lits, lits);
+                m_fast_glue_avg.update(glue);
+                m_slow_glue_avg.update(glue);
+                m_stats.m_num_learned_glue++;
+                m_stats.m_sum_learned_glue += glue;
+            }
+            mk_clause(num_lits, lits, js, CLS_LEARNED, nullptr, glue);
+            if (m_par) 
+                m_par->share_clause(*this, num_lits, lits);
             if (delay_forced_restart) {
                 SASSERT(num_lits == 1);
                 expr * unit     = bool_var2expr(lits[0].var());
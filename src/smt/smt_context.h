@@ -41,11 +41,13 @@ Revision History:
 #include "smt/smt_types.h"
 #include "smt/dyn_ack.h"
 #include "ast/ast_smt_pp.h"
+#include "ast/ast_translation.h"
 #include "smt/watch_list.h"
 #include "util/trail.h"
 #include "util/ref.h"
 #include "util/timer.h"
 #include "util/statistics.h"
+#include "util/ema.h"
 #include "smt/fingerprints.h"
 #include "smt/proto_model/proto_model.h"
 #include "smt/user_propagator.h"
@@ -887,7 +889,7 @@ namespace smt {
 
         void internalize(expr * n, bool gate_ctx, unsigned generation);
 
-        clause * mk_clause(unsigned num_lits, literal * lits, justification * j, clause_kind k = CLS_AUX, clause_del_eh * del_eh = nullptr);
+        clause * mk_clause(unsigned num_lits, literal * lits, justification * j, clause_kind k = CLS_AUX, clause_del_eh * del_eh = nullptr, unsigned glue = UINT_MAX);
 
         void mk_clause(literal l1, literal l2, justification * j);
 
@@ -984,6 +986,10 @@ namespace smt {
         unsigned           m_luby_idx;
         double             m_agility;
         unsigned           m_lemma_gc_threshold;
+        ema                m_fast_glue_avg;
+        ema                m_slow_glue_avg;
+        unsigned_vector    m_glue_marks;
+        unsigned           m_glue_stamp;
 
         void assign_core(literal l, b_justification j, bool decision = false);
         void trace_assign(literal l, b_justification j, bool decision) const;
@@ -1183,6 +1189,22 @@ namespace smt {
 
         void del_inactive_lemmas2();
 
+        void del_inactive_lemmas3();
+
+        unsigned compute_glue(unsigned num_lits, literal const * lits);
+
+        /**
+           \brief glue of lemmas is only maintained for tiered lemma garbage collection and EMA restarts.
+        */
+        bool track_glue() const { return m_fparams.m_lemma_gc_tiered || m_fparams.m_restart_strategy == RS_EMA; }
+
+        bool should_restart() const;
+
+    public:
+        void update_glue(clause * cls);
+
+    protected:
+
         bool more_than_k_unassigned_literals(clause * cls, unsigned k);
 
         void internalize_assertions();
@@ -1570,8 +1592,6 @@ namespace smt {
 
         void log_stats();
 
-        void copy_user_propagator(context& src);
-
     public:
         context(ast_manager & m, smt_params & fp, params_ref const & p = params_ref());
 
@@ -1589,6 +1609,35 @@ namespace smt {
 
         static void copy(context& src, context& dst, bool override_base = false);
 
+        /**
+           \brief Formulas of a context at base level, collected once in the source manager.
+           The snapshot is read-only after construction. copy_formulas translates it into
+           a destination context, and can run concurrently for several destinations
+           as long as the source manager is not modified meanwhile.
+        */
+        struct copy_snapshot {
+            ast_manager&      m;
+            expr_ref_vector   m_fmls;
+            proof_ref_vector  m_prs;
+            expr_ref_vector   m_units;
+            expr_ref_vector   m_user_vars;
+            bool              m_configured { false };
+            bool              m_has_user_propagator { false };
+            copy_snapshot(ast_manager& m): m(m), m_fmls(m), m_prs(m), m_units(m), m_user_vars(m) {}
+        };
+
+        /**
+           \brief Split version of copy: mk_copy_snapshot and copy_prepare are run on the
+           thread owning src, copy_formulas can be run on the thread owning dst.
+        */
+        void mk_copy_snapshot(copy_snapshot& s, bool override_base);
+
+        static void copy_prepare(context& src, context& dst);
+
+        void copy_formulas(copy_snapshot const& s);
+
+        void copy_user_propagator(copy_snapshot const& s, ast_translation& tr);
+
         /**
            \brief Translate context to use new manager m.
          */
@@ -387,6 +387,12 @@ namespace smt {
         st.update("added eqs", m_stats.m_num_add_eq);
         st.update("mk clause", m_stats.m_num_mk_clause);
         st.update("del clause", m_stats.m_num_del_clause);
+        st.update("lemma core", m_stats.m_num_core_lemmas);
+        st.update("lemma del tier2", m_stats.m_num_del_tier2_lemmas);
+        st.update("lemma del local", m_stats.m_num_del_local_lemmas);
+        st.update("lemma glue updates", m_stats.m_num_glue_updates);
+        if (m_stats.m_num_learned_glue > 0)
+            st.update("lemma avg glue", m_stats.m_sum_learned_glue / m_stats.m_num_learned_glue);
         st.update("dyn ack", m_stats.m_num_dyn_ack);
         st.update("interface eqs", m_stats.m_num_interface_eqs);
         st.update("max generation", m_stats.m_max_generation);
@@ -1347,7 +1347,7 @@ namespace smt {
        \brief Create a new clause using the given literals, justification, kind and deletion event handler.
        The deletion event handler is ignored if binary clause optimization is applicable.
     */
-    clause * context::mk_clause(unsigned num_lits, literal * lits, justification * j, clause_kind k, clause_del_eh * del_eh) {
+    clause * context::mk_clause(unsigned num_lits, literal * lits, justification * j, clause_kind k, clause_del_eh * del_eh, unsigned glue) {
         TRACE("mk_clause", display_literals_verbose(tout << "creating clause: " << literal_vector(num_lits, lits) << "\n", num_lits, lits) << "\n";);
         m_clause_proof.add(num_lits, lits, k, j);
         switch (k) {
@@ -1427,6 +1427,13 @@ namespace smt {
             m_clause_proof.add(*cls);
             if (lemma) {
                 cls->set_activity(activity);
+                if (m_fparams.m_lemma_gc_tiered) {
+                    if (glue == UINT_MAX)
+                        glue = compute_glue(num_lits, lits);
+                    cls->set_glue(glue);
+                    if (glue <= m_fparams.m_lemma_gc_core_glue)
+                        m_stats.m_num_core_lemmas++;
+                }
                 if (k == CLS_LEARNED) {
                     int w2_idx  = select_learned_watch_lit(cls);
                     cls->swap_lits(1, w2_idx);
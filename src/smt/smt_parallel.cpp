@@ -24,6 +24,115 @@ Author:
 #include "smt/smt_parallel.h"
 #include "smt/smt_lookahead.h"
 
+namespace smt {
+
+    void parallel::init_shared_atoms(unsigned i, context& pctx, ast_translation& tr) {
+        svector<bool_var>& l2s = m_local2shared[i];
+        svector<bool_var>& s2l = m_shared2local[i];
+        unsigned num_vars = ctx.get_num_bool_vars();
+        l2s.reset();
+        s2l.reset();
+        l2s.resize(pctx.get_num_bool_vars(), null_bool_var);
+        s2l.resize(num_vars, null_bool_var);
+        for (unsigned v = 0; v < num_vars; ++v) {
+            expr* e = ctx.bool_var2expr(v);
+            if (!e) 
+                continue;
+            expr* pe = tr(e);
+            if (!pctx.b_internalized(pe)) 
+                continue;
+            bool_var w = pctx.get_bool_var(pe);
+            if (static_cast<unsigned>(w) >= l2s.size() || l2s[w] != null_bool_var) 
+                continue;
+            l2s[w] = v;
+            s2l[v] = w;
+        }
+    }
+
+    bool parallel::check_shared_atoms() const {
+        for (unsigned i = 0; i < m_local2shared.size(); ++i) {
+            svector<bool_var> const& l2s = m_local2shared[i];
+            svector<bool_var> const& s2l = m_shared2local[i];
+            for (unsigned w = 0; w < l2s.size(); ++w) {
+                bool_var v = l2s[w];
+                if (v != null_bool_var && (static_cast<unsigned>(v) >= s2l.size() || s2l[v] != static_cast<bool_var>(w)))
+                    return false;
+            }
+            for (unsigned v = 0; v < s2l.size(); ++v) {
+                bool_var w = s2l[v];
+                if (w != null_bool_var && (static_cast<unsigned>(w) >= l2s.size() || l2s[w] != static_cast<bool_var>(v)))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void parallel::reset_pool() {
+        m_pool.reset();
+        for (unsigned& h : m_pool_heads) 
+            h = 0;
+    }
+
+    void parallel::share_clause(context& pctx, unsigned n, literal const* lits) {
+        unsigned i = pctx.m_par_index;
+        if (n > pctx.get_fparams().m_threads_share_size) 
+            return;
+        svector<bool_var> const& l2s = m_local2shared[i];
+        for (unsigned j = 0; j < n; ++j) {
+            unsigned v = lits[j].var();
+            if (v >= l2s.size() || l2s[v] == null_bool_var) 
+                return;
+        }
+        if (pctx.compute_glue(n, lits) > pctx.get_fparams().m_threads_share_glue) 
+            return;
+        lock_guard lock(m_mux);
+        if (m_pool.size() + n + 2 > m_max_pool_size) 
+            return;
+        m_pool.push_back(i);
+        m_pool.push_back(n);
+        for (unsigned j = 0; j < n; ++j) 
+            m_pool.push_back(literal(l2s[lits[j].var()], lits[j].sign()).index());
+        m_stats.m_num_shared++;
+    }
+
+    void parallel::get_clauses(context& pctx) {
+        unsigned i = pctx.m_par_index;
+        svector<bool_var> const& s2l = m_shared2local[i];
+        literal_vector lits;
+        vector<literal_vector> clauses;
+        {
+            lock_guard lock(m_mux);
+            unsigned head = m_pool_heads[i];
+            unsigned sz = m_pool.size();
+            while (head < sz) {
+                unsigned owner = m_pool[head];
+                unsigned n = m_pool[head + 1];
+                unsigned const* shared_lits = m_pool.c_ptr() + head + 2;
+                head += n + 2;
+                if (owner == i) 
+                    continue;
+                lits.reset();
+                for (unsigned j = 0; j < n; ++j) {
+                    literal lit = to_literal(shared_lits[j]);
+                    bool_var w = s2l[lit.var()];
+                    if (w == null_bool_var) 
+                        break;
+                    lits.push_back(literal(w, lit.sign()));
+                }
+                if (lits.size() == n) 
+                    clauses.push_back(lits);
+            }
+            m_pool_heads[i] = head;
+            m_stats.m_num_imported += clauses.size();
+        }
+        for (literal_vector& c : clauses) {
+            if (pctx.inconsistent()) 
+                break;
+            pctx.mk_clause(c.size(), c.c_ptr(), nullptr, CLS_TH_LEMMA);
+        }
+    }
+}
+
 #ifdef SINGLE_THREAD
 
 namespace smt {
@@ -80,16 +189,85 @@ namespace smt {
         for (unsigned i = 0; i < num_threads; ++i) {
             smt_params.push_back(ctx.get_fparams());
         }
+        // The formulas of ctx are collected once into a read-only snapshot.
+        // Each worker translates and internalizes the snapshot on its own thread,
+        // so startup cost is no longer proportional to the number of threads.
+        context::copy_snapshot snapshot(m);
+        ctx.mk_copy_snapshot(snapshot, true);
         for (unsigned i = 0; i < num_threads; ++i) {
             ast_manager* new_m = alloc(ast_manager, m, true);
             pms.push_back(new_m);
             pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
             context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
+            context::copy_prepare(ctx, new_ctx);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
-            pasms.push_back(tr(asms));
+            pasms.push_back(expr_ref_vector(*new_m));
             sl.push_child(&(new_m->limit()));
+            m_local2shared.push_back(svector<bool_var>());
+            m_shared2local.push_back(svector<bool_var>());
+            m_pool_heads.push_back(0);
+        }
+
+        std::mutex mux;
+
+        // the first failed copy is reported, the other copies are canceled.
+        auto copy_failed = [&](par_exception_kind k, unsigned code, char const* msg) {
+            std::lock_guard<std::mutex> lock(mux);
+            if (!done) {
+                done = true;
+                ex_kind = k;
+                error_code = code;
+                if (msg)
+                    ex_msg = msg;
+            }
+            for (ast_manager* pm : pms)
+                pm->limit().cancel();
+        };
+
+        auto copy_thread = [&](unsigned i) {
+            try {
+                context& new_ctx = *pctxs[i];
+                ast_translation tr(m, *pms[i], false);
+                tr.freeze_from();
+                new_ctx.copy_formulas(snapshot);
+                for (expr* a : asms) 
+                    pasms[i].push_back(tr(a));
+                init_shared_atoms(i, new_ctx, tr);
+            }
+            catch (z3_error & err) {
+                copy_failed(ERROR_EX, err.error_code(), nullptr);
+            }
+            catch (z3_exception & ex) {
+                copy_failed(DEFAULT_EX, 0, ex.msg());
+            }
+        };
+
+        if (snapshot.m_has_user_propagator) {
+            // user propagator callbacks are not assumed to be re-entrant
+            for (unsigned i = 0; i < num_threads; ++i) 
+                copy_thread(i);
+        }
+        else {
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) {
+                threads[i] = std::thread([&, i]() { copy_thread(i); });
+            }
+            for (auto & th : threads) {
+                th.join();
+            }
+        }
+        SASSERT(done || check_shared_atoms());
+        if (done) {
+            switch (ex_kind) {
+            case ERROR_EX: throw z3_error(error_code);
+            default: throw default_exception(std::move(ex_msg));
+            }
+        }
+        if (ctx.get_fparams().m_threads_share_size > 0) {
+            for (unsigned i = 0; i < num_threads; ++i) {
+                pctxs[i]->m_par = this;
+                pctxs[i]->m_par_index = i;
+            }
         }
 
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
@@ -107,11 +285,21 @@ namespace smt {
         unsigned_vector unit_lim;
         for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
 
+        // units are exchanged every round, the translations keep the atoms copied in earlier rounds.
+        scoped_ptr_vector<ast_translation> to_main, from_main;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            to_main.push_back(alloc(ast_translation, *pms[i], m, false));
+            from_main.push_back(alloc(ast_translation, m, *pms[i], false));
+            to_main[i]->set_persistent(true);
+            from_main[i]->set_persistent(true);
+            to_main[i]->set_inverse(*from_main[i]);
+        }
+
         std::function<void(void)> collect_units = [&,this]() {
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
                 pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
+                ast_translation& tr = *to_main[i];
                 unsigned sz = pctx.assigned_literals().size();
                 for (unsigned j = unit_lim[i]; j < sz; ++j) {
                     literal lit = pctx.assigned_literals()[j];
@@ -128,7 +316,7 @@ namespace smt {
             unsigned sz = unit_trail.size();
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
+                ast_translation& tr = *from_main[i];
                 for (unsigned j = unit_lim[i]; j < sz; ++j) {
                     expr_ref src(ctx.m), dst(pctx.m);
                     dst = tr(unit_trail.get(j));
@@ -139,8 +327,6 @@ namespace smt {
             IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
         };
 
-        std::mutex mux;
-
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
@@ -217,14 +403,18 @@ namespace smt {
             if (done) break;
 
             collect_units();
+            reset_pool();
             ++num_rounds;
             max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
             thread_max_conflicts *= 2;            
         }
 
         for (context* c : pctxs) {
+            c->m_par = nullptr;
             c->collect_statistics(ctx.m_aux_stats);
         }
+        ctx.m_aux_stats.update("parallel clauses shared", m_stats.m_num_shared);
+        ctx.m_aux_stats.update("parallel clauses imported", m_stats.m_num_imported);
 
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
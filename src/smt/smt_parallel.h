@@ -18,17 +18,56 @@ Revision History:
 --*/
 #pragma once
 
+#include "util/mutex.h"
 #include "smt/smt_context.h"
 
 namespace smt {
 
     class parallel {
         context& ctx;
+
+        /**
+           \brief Learned clauses are exchanged between workers during search.
+           Literals are expressed over the Boolean variables of the main context (shared atoms),
+           so no AST translation is needed when clauses are exchanged.
+        */
+        struct stats {
+            unsigned m_num_shared;
+            unsigned m_num_imported;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+        mutex                       m_mux;
+        unsigned_vector             m_pool;          // sequence of entries: owner, size, shared literal indices
+        unsigned_vector             m_pool_heads;    // per worker position of the next entry to import
+        vector<svector<bool_var>>   m_local2shared;  // per worker map from local Boolean variable to shared atom
+        vector<svector<bool_var>>   m_shared2local;  // per worker map from shared atom to local Boolean variable
+        unsigned                    m_max_pool_size { 1 << 20 };
+        stats                       m_stats;
+
+        void init_shared_atoms(unsigned i, context& pctx, ast_translation& tr);
+        void reset_pool();
+
     public:
         parallel(context& ctx): ctx(ctx) {}
 
         lbool operator()(expr_ref_vector const& asms);
 
+        /**
+           \brief Called by worker pctx when it learns a clause.
+         */
+        void share_clause(context& pctx, unsigned n, literal const* lits);
+
+        /**
+           \brief Called by worker pctx at restarts to import clauses learned by other workers.
+         */
+        void get_clauses(context& pctx);
+
+        /**
+           \brief Check that the maps between local Boolean variables and shared atoms are inverse of each other.
+         */
+        bool check_shared_atoms() const;
+
     };
 
 }
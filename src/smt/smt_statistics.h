@@ -47,6 +47,12 @@ namespace smt {
         unsigned m_num_checks;
         unsigned m_num_simplifications;
         unsigned m_num_del_clauses;
+        unsigned m_num_core_lemmas;
+        unsigned m_num_del_tier2_lemmas;
+        unsigned m_num_del_local_lemmas;
+        unsigned m_num_glue_updates;
+        unsigned m_num_learned_glue;
+        double   m_sum_learned_glue;
         statistics() {
             reset();
         }
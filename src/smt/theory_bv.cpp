@@ -505,6 +505,13 @@ namespace smt {
         else {
             m_fixed_var_table.insert(key, v);
         }
+        if (!m_lazy_terms.empty()) {
+            unsigned idx;
+            for (enode * p : enode::parents(n->get_root())) {
+                if (m_lazy_index.find(p->get_owner(), idx) && !m_lazy_blasted[idx])
+                    m_lazy_queue.push_back(idx);
+            }
+        }
     }
 
     bool theory_bv::get_fixed_value(theory_var v, numeral & result)  const {
@@ -854,6 +861,10 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (is_lazy(term)) {
+            internalize_lazy(term);
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BADD:           internalize_add(term); return true;
@@ -908,6 +919,155 @@ namespace smt {
         }
     }
 
+    bool theory_bv::is_lazy(app * n) const {
+        unsigned min_size = params().m_bv_lazy_blast;
+        if (min_size == 0)
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BSDIV_I:
+        case OP_BUDIV_I:
+        case OP_BSREM_I:
+        case OP_BUREM_I:
+        case OP_BSMOD_I:
+            return get_bv_size(n) >= min_size;
+        default:
+            return false;
+        }
+    }
+
+    /**
+       \brief Internalize n with fresh bits. The circuit for n is only created by blast_lazy.
+    */
+    void theory_bv::internalize_lazy(app * n) {
+        SASSERT(!ctx.e_internalized(n));
+        process_args(n);
+        enode * e       = mk_enode(n);
+        theory_var v    = e->get_th_var(get_id());
+        mk_bits(v);
+        for (unsigned i = 0; i < n->get_num_args(); ++i)
+            get_arg_var(e, i);
+        unsigned idx    = m_lazy_terms.size();
+        m_lazy_terms.push_back(n);
+        m_lazy_blasted.push_back(false);
+        m_lazy_num_axioms.push_back(0);
+        m_lazy_index.insert(n, idx);
+        m_trail_stack.push(push_back_vector<theory_bv, ptr_vector<app>>(m_lazy_terms));
+        m_trail_stack.push(push_back_vector<theory_bv, svector<bool>>(m_lazy_blasted));
+        m_trail_stack.push(push_back_vector<theory_bv, unsigned_vector>(m_lazy_num_axioms));
+        m_trail_stack.push(insert_obj_map<theory_bv, app, unsigned>(m_lazy_index, n));
+        m_lazy_queue.push_back(idx);
+        m_stats.m_num_lazy_terms++;
+        TRACE("bv", tout << "lazy: " << mk_bounded_pp(n, m) << "\n";);
+    }
+
+    /**
+       \brief Check that the value of the lazy term at idx is consistent with the values
+       of its arguments. If it is not, add an axiom that fixes the value of the term
+       for the current values of the arguments, or bit-blast the term.
+       Return false if a new axiom was added.
+    */
+    bool theory_bv::check_lazy(unsigned idx, bool is_final) {
+        if (m_lazy_blasted[idx])
+            return true;
+        app * n         = m_lazy_terms[idx];
+        enode * e       = ctx.get_enode(n);
+        if (!ctx.is_relevant(e))
+            return true;
+        expr_ref_vector args(m);
+        literal_vector lits;
+        bool all_fixed  = true;
+        for (unsigned i = 0; i < n->get_num_args(); ++i) {
+            theory_var arg = get_arg_var(e, i);
+            numeral val;
+            if (!get_fixed_value(arg, val)) {
+                all_fixed = false;
+                if (is_final) {
+                    for (literal b : m_bits[arg]) 
+                        if (!ctx.is_relevant(b)) ctx.mark_as_relevant(b);
+                }
+                continue;
+            }
+            args.push_back(m_util.mk_numeral(val, get_bv_size(arg)));
+            for (literal b : m_bits[arg]) 
+                lits.push_back(ctx.get_assignment(b) == l_true ? ~b : b);
+        }
+        if (!all_fixed)
+            return !is_final;
+        expr_ref val(m.mk_app(n->get_decl(), args.size(), args.c_ptr()), m);
+        ctx.get_rewriter()(val);
+        numeral r, cur;
+        unsigned sz;
+        theory_var v    = e->get_th_var(get_id());
+        bool is_num     = m_util.is_numeral(val, r, sz);
+        if (is_num && get_fixed_value(v, cur) && cur == r)
+            return true;
+        if (!is_num || m_lazy_num_axioms[idx] >= m_lazy_axiom_limit) {
+            blast_lazy(idx);
+            return false;
+        }
+        m_lazy_num_axioms[idx]++;
+        m_stats.m_num_lazy_axioms++;
+        literal eq      = mk_eq(n, val, false);
+        ctx.mark_as_relevant(eq);
+        lits.push_back(eq);
+        TRACE("bv", tout << "lazy axiom: " << mk_bounded_pp(n, m) << " = " << val << "\n";);
+        ctx.mk_th_axiom(get_id(), lits.size(), lits.c_ptr());
+        return false;
+    }
+
+    /**
+       \brief Create the circuit for the lazy term at idx and connect its outputs to the bits of the term.
+    */
+    void theory_bv::blast_lazy(unsigned idx) {
+        SASSERT(!m_lazy_blasted[idx]);
+        app * n         = m_lazy_terms[idx];
+        m_trail_stack.push(vector_value_trail<theory_bv, bool, false>(m_lazy_blasted, idx));
+        m_lazy_blasted[idx] = true;
+        m_stats.m_num_lazy_blasted++;
+        TRACE("bv", tout << "blast: " << mk_bounded_pp(n, m) << "\n";);
+        enode * e       = ctx.get_enode(n);
+        theory_var v    = e->get_th_var(get_id());
+        expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m), new_bits(m);
+        if (n->get_decl_kind() == OP_BMUL) {
+            unsigned i = n->get_num_args() - 1;
+            get_arg_bits(e, i, bits);
+            while (i > 0) {
+                --i;
+                arg1_bits.reset();
+                new_bits.reset();
+                get_arg_bits(e, i, arg1_bits);
+                m_bb.mk_multiplier(arg1_bits.size(), arg1_bits.c_ptr(), bits.c_ptr(), new_bits);
+                bits.swap(new_bits);
+            }
+        }
+        else {
+            SASSERT(n->get_num_args() == 2);
+            get_arg_bits(e, 0, arg1_bits);
+            get_arg_bits(e, 1, arg2_bits);
+            unsigned sz = arg1_bits.size();
+            switch (n->get_decl_kind()) {
+            case OP_BSDIV_I: m_bb.mk_sdiv(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BUDIV_I: m_bb.mk_udiv(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BSREM_I: m_bb.mk_srem(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BUREM_I: m_bb.mk_urem(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            case OP_BSMOD_I: m_bb.mk_smod(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); break;
+            default: UNREACHABLE(); break;
+            }
+        }
+        SASSERT(bits.size() == m_bits[v].size());
+        ctx.internalize(bits.c_ptr(), bits.size(), true);
+        for (unsigned i = 0; i < bits.size(); ++i) {
+            literal l   = ctx.get_literal(bits.get(i));
+            literal b   = m_bits[v][i];
+            if (l == b)
+                continue;
+            ctx.mark_as_relevant(l);
+            ctx.mk_th_axiom(get_id(), ~l, b);
+            ctx.mk_th_axiom(get_id(), l, ~b);
+        }
+    }
+
     bool theory_bv::internalize_term(app * term) {
         scoped_suspend_rlimit _suspend_cancel(m.limit());
         try {
@@ -1381,6 +1541,7 @@ namespace smt {
         }
         m_diseq_watch_trail.shrink(old_trail_sz);
         m_diseq_watch_lim.shrink(m_diseq_watch_lim.size()-num_scopes);
+        m_lazy_queue.reset();
         theory::pop_scope_eh(num_scopes);
         TRACE("bv_verbose", m_find.display(tout << ctx.get_scope_level() << " - " 
                                    << num_scopes << " = " << (ctx.get_scope_level() - num_scopes) << "\n"););
@@ -1388,6 +1549,12 @@ namespace smt {
 
     final_check_status theory_bv::final_check_eh() {
         SASSERT(check_invariant());
+        bool lazy_ok = true;
+        for (unsigned idx = 0; idx < m_lazy_terms.size() && !ctx.inconsistent(); ++idx) 
+            if (!check_lazy(idx, true))
+                lazy_ok = false;
+        if (!lazy_ok)
+            return FC_CONTINUE;
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
@@ -1561,6 +1728,9 @@ namespace smt {
             }
             m_replay_diseq.reset();
         }
+        for (unsigned i = 0; i < m_lazy_queue.size() && !ctx.inconsistent(); ++i) 
+            check_lazy(m_lazy_queue[i], false);
+        m_lazy_queue.reset();
     }
 
     class bit_eq_justification : public justification {
@@ -1768,6 +1938,10 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv lazy terms", m_stats.m_num_lazy_terms);
+        st.update("bv lazy blasted", m_stats.m_num_lazy_blasted);
+        st.update("bv lazy axioms", m_stats.m_num_lazy_axioms);
+        st.update("bv circuit cache hits", m_bb.get_num_circuit_hits());
     }
 
     bool theory_bv::check_assignment(theory_var v) {
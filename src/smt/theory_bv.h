@@ -31,6 +31,7 @@ namespace smt {
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
         unsigned   m_num_eq_dynamic;
+        unsigned   m_num_lazy_terms, m_num_lazy_blasted, m_num_lazy_axioms;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -135,6 +136,18 @@ namespace smt {
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
 
+        // Lazy bit-blasting (bv.lazy_blast):
+        // wide multiplication, division and remainder terms start out with fresh bits.
+        // When their arguments are fixed, the result is propagated at word level by an
+        // axiom relating the argument bits to the evaluated value. A term is bit-blasted
+        // once it required more than m_lazy_axiom_limit such axioms.
+        ptr_vector<app>          m_lazy_terms;
+        svector<bool>            m_lazy_blasted;
+        unsigned_vector          m_lazy_num_axioms;
+        obj_map<app, unsigned>   m_lazy_index;
+        unsigned_vector          m_lazy_queue;
+        unsigned                 m_lazy_axiom_limit { 8 };
+
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
         bool is_root(theory_var v) const { return m_find.is_root(v); }
@@ -213,6 +226,11 @@ namespace smt {
 
         bool approximate_term(app* n);
 
+        bool is_lazy(app* n) const;
+        void internalize_lazy(app* n);
+        bool check_lazy(unsigned idx, bool is_final);
+        void blast_lazy(unsigned idx);
+
         template<bool Signed>
         void internalize_le(app * atom);
         bool internalize_xor3(app * n, bool gate_ctx);
@@ -240,7 +258,7 @@ namespace smt {
         bool include_func_interp(func_decl* f) override;
         svector<theory_var>   m_merge_aux[2]; //!< auxiliary vector used in merge_zero_one_bits
         bool merge_zero_one_bits(theory_var r1, theory_var r2);
-        bool can_propagate() override { return !m_replay_diseq.empty(); }
+        bool can_propagate() override { return !m_replay_diseq.empty() || !m_lazy_queue.empty(); }
         void propagate() override;
 
         // -----------------------------------
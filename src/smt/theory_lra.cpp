@@ -885,6 +885,9 @@ public:
         lp().settings().report_frequency = lpar.arith_rep_freq();
         lp().settings().print_statistics = lpar.arith_print_stats();
         lp().settings().cheap_eqs() = lpar.arith_cheap_eqs();
+        lp().settings().bound_flips() = lpar.arith_bound_flips();
+        lp().settings().int_bnb_threads() = lpar.arith_bnb_threads();
+        lp().settings().int_bnb_max_nodes() = lpar.arith_bnb_max_nodes();
 
         // todo : do not use m_arith_branch_cut_ratio for deciding on cheap cuts
         unsigned branch_cut_ratio = ctx().get_fparams().m_arith_branch_cut_ratio;
@@ -19,16 +19,27 @@ Notes:
 #include "tactic/core/simplify_tactic.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "tactic/tactic_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#endif
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
+    params_ref      m_params;
     unsigned        m_num_steps;
+    unsigned        m_threads;
+    unsigned        m_min_shard_size;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
         m_num_steps(0) {
+        updt_params(p);
     }
 
     ~imp() {
@@ -36,6 +47,14 @@ struct simplify_tactic::imp {
 
     ast_manager & m() const { return m_manager; }
 
+    void updt_params(params_ref const & p) {
+        tactic_params tp(p);
+        m_params         = p;
+        m_threads        = p.get_uint("threads", tp.simplify_threads());
+        m_min_shard_size = std::max(1u, p.get_uint("min_shard_size", tp.simplify_min_shard_size()));
+        m_r.updt_params(p);
+    }
+
 
     void reset() {
         m_r.reset();
@@ -47,6 +66,18 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        unsigned size = g.size();
+        unsigned num_threads = std::min(m_threads, size / m_min_shard_size);
+        if (num_threads > 1 && !g.proofs_enabled() && !m().has_trace_stream()) 
+            simplify_parallel(g, num_threads);
+        else
+            simplify_sequential(g);
+        TRACE("simplifier", g.display(tout););
+        g.elim_redundancies();
+        TRACE("after_simplifier_detail", g.display_with_dependencies(tout););
+    }
+
+    void simplify_sequential(goal & g) {
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -62,9 +93,81 @@ struct simplify_tactic::imp {
             }
             g.update(idx, new_curr, new_pr, g.dep(idx));
         }
-        TRACE("simplifier", g.display(tout););
-        g.elim_redundancies();
-        TRACE("after_simplifier_detail", g.display_with_dependencies(tout););
+    }
+
+    /**
+       \brief Simplify the formulas of g in num_threads shards of consecutive formulas.
+       The formulas of a shard are copied into a separate manager, rewritten there by a
+       worker thread, and copied back into g.
+    */
+    void simplify_parallel(goal & g, unsigned num_threads) {
+#ifdef SINGLE_THREAD
+        simplify_sequential(g);
+#else
+        unsigned size = g.size();
+        unsigned shard_size = (size + num_threads - 1) / num_threads;
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_ptr_vector<expr_ref_vector> shards;
+        scoped_limits scl(m().limit());
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager * new_m = alloc(ast_manager, m(), true);
+            managers.push_back(new_m);
+            scl.push_child(&new_m->limit());
+            ast_translation tr(m(), *new_m);
+            expr_ref_vector * shard = alloc(expr_ref_vector, *new_m);
+            for (unsigned idx = i * shard_size; idx < size && idx < (i + 1) * shard_size; ++idx)
+                shard->push_back(tr(g.form(idx)));
+            shards.push_back(shard);
+        }
+
+        std::mutex  mux;
+        std::string ex_msg;
+        bool        failed = false;
+        unsigned_vector num_steps(num_threads, 0u);
+        auto worker = [&](unsigned i) {
+            try {
+                expr_ref_vector & shard = *shards[i];
+                th_rewriter rw(*managers[i], m_params);
+                expr_ref r(*managers[i]);
+                for (unsigned j = 0; j < shard.size(); ++j) {
+                    rw(shard.get(j), r);
+                    num_steps[i] += rw.get_num_steps();
+                    shard[j] = r;
+                }
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!failed) {
+                    failed = true;
+                    ex_msg = ex.msg();
+                }
+                for (ast_manager * new_m : managers)
+                    new_m->limit().cancel();
+            }
+        };
+        vector<std::thread> threads;
+        for (unsigned i = 1; i < num_threads; ++i)
+            threads.push_back(std::thread([&, i]() { worker(i); }));
+        worker(0);
+        for (std::thread & t : threads)
+            t.join();
+        if (failed)
+            throw rewriter_exception(std::move(ex_msg));
+
+        for (unsigned i = 0; i < num_threads && !g.inconsistent(); ++i) {
+            m_num_steps += num_steps[i];
+            ast_translation tr(*managers[i], m(), false);
+            expr_ref_vector & shard = *shards[i];
+            expr_ref new_curr(m());
+            for (unsigned j = 0; j < shard.size() && !g.inconsistent(); ++j) {
+                unsigned idx = i * shard_size + j;
+                new_curr = tr(shard.get(j));
+                g.update(idx, new_curr, nullptr, g.dep(idx));
+            }
+        }
+        // release the formulas before their managers
+        shards.reset();
+#endif
     }
 
     unsigned get_num_steps() const { return m_num_steps; }
@@ -81,11 +184,13 @@ simplify_tactic::~simplify_tactic() {
 
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params = p;
-    m_imp->m_r.updt_params(p);
+    m_imp->updt_params(p);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
     th_rewriter::get_param_descrs(r);
+    r.insert("threads", CPK_UINT, "(default: 1) number of threads used to simplify the formulas of a goal.");
+    r.insert("min_shard_size", CPK_UINT, "(default: 1000) minimal number of formulas simplified by one thread.");
 }
 
 void simplify_tactic::operator()(goal_ref const & in, 
@@ -108,6 +213,10 @@ void simplify_tactic::cleanup() {
     new (m_imp) imp(m, p);
 }
 
+void simplify_tactic::collect_statistics(statistics & st) const {
+    m_imp->m_r.collect_statistics(st);
+}
+
 unsigned simplify_tactic::get_num_steps() const {
     return m_imp->get_num_steps();
 }
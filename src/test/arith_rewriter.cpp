@@ -8,6 +8,8 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/ast_pp.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "ast/expr_lru_cache.h"
+#include "util/gparams.h"
 #include "model/model.h"
 #include "parsers/smt2/smt2parser.h"
 
@@ -56,4 +58,29 @@ void tst_arith_rewriter() {
     fml = parse_fml(m, example2);
     rw(fml);
     std::cout << mk_pp(fml, m) << "\n";
+
+    // rewriters with the same parameters share results through the manager
+    params_ref p;
+    p.set_uint("persistent_cache", 2);
+    th_rewriter rw1(m, p), rw2(m, p);
+    expr_ref f1 = parse_fml(m, example1), f2 = parse_fml(m, example2), r1(m), r2(m);
+    rw1(f1, r1);
+    rw2(f1, r2);
+    ENSURE(r1 == r2);
+    ENSURE(rw2.get_num_steps() == 0);
+    rw2(f2, r2);
+    rw2(r2, r1);
+    ENSURE(m.rewrite_cache().size() == 2);
+
+    // the global rewriter parameters are part of the settings
+    gparams::set("rewriter.som", "true");
+    th_rewriter rw3(m, p);
+    gparams::set("rewriter.som", "false");
+    rw1(f2, r1);
+    ENSURE(rw1.get_num_steps() == 0);
+    rw3(f2, r2);
+    ENSURE(rw3.get_num_steps() > 0);
+    statistics st;
+    rw2.collect_statistics(st);
+    st.display(std::cout);
 }
@@ -17,6 +17,10 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include "ast/ast_translation.h"
+#include "util/memory_manager.h"
+#include "util/stopwatch.h"
+#include <cstdlib>
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +135,172 @@ static void tst5() {
     m.del(arr3);
 }
 
+static void tst6() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    expr_ref a(m.mk_const(symbol("a"), b.get()), m);
+    expr_ref c(m.mk_const(symbol("c"), b.get()), m);
+    ENSURE(to_app(a)->get_depth() == 1);
+    ENSURE(to_app(a)->is_ground());
+    ENSURE(!to_app(a)->has_quantifiers());
+    expr_ref x(m.mk_var(0, b.get()), m);
+    app_ref t1(m.mk_and(a, c), m);
+    app_ref t2(m.mk_or(t1, x), m);
+    app_ref t3(m.mk_not(t2), m);
+    ENSURE(t1->get_depth() == 2 && t1->is_ground());
+    ENSURE(t2->get_depth() == 3 && !t2->is_ground());
+    ENSURE(t3->get_depth() == 4 && !t3->is_ground() && !t3->has_quantifiers());
+    ENSURE(t1->get_size() == sizeof(app) + 2 * sizeof(expr*));
+}
+
+#ifndef SINGLE_THREAD
+#include <thread>
+
+// threads of a concurrent manager share the terms they create
+static void tst7() {
+    ast_manager m;
+    m.set_concurrent(true);
+    sort_ref b(m.mk_bool_sort(), m);
+    unsigned num_asts = m.get_num_asts();
+    unsigned const n = 100;
+    auto mk_chain = [&](unsigned k) {
+        expr_ref r(m.mk_true(), m);
+        for (unsigned i = 0; i < n; ++i) {
+            expr_ref c(m.mk_const(symbol(i), b), m);
+            r = (i + k) % 2 == 0 ? m.mk_and(r, c) : m.mk_or(r, m.mk_not(c));
+        }
+        return r;
+    };
+    expr_ref expected(mk_chain(0), m);
+    vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            for (unsigned j = 0; j < 100; ++j) {
+                expr_ref r = mk_chain(t + j);
+                ENSURE((t + j) % 2 != 0 || r == expected);
+            }
+        }));
+    }
+    for (std::thread & t : threads)
+        t.join();
+    expected.reset();
+    m.collect_garbage();
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
+static void tst10() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    expr_ref_vector args(m);
+    for (unsigned i = 0; i < 5; ++i)
+        args.push_back(m.mk_const(symbol(i), b));
+    // hash-consing compares the arguments pairwise and the odd last one
+    for (unsigned n = 1; n <= 5; ++n) {
+        expr_ref t1(m.mk_or(n, args.c_ptr()), m);
+        expr_ref t2(m.mk_or(n, args.c_ptr()), m);
+        ENSURE(t1 == t2);
+        expr_ref_vector args2(args);
+        args2.set(n - 1, m.mk_not(args.get(n - 1)));
+        expr_ref t3(m.mk_or(n, args2.c_ptr()), m);
+        ENSURE(t1 != t3);
+    }
+}
+#else
+static void tst7() {
+}
+#endif
+
+// persistent translations only copy nodes that were not translated before
+static void tst8() {
+    ast_manager m1, m2;
+    ast_translation to2(m1, m2), to1(m2, m1, false);
+    to2.set_persistent(true);
+    to1.set_persistent(true);
+    to2.set_inverse(to1);
+    sort_ref b(m1.mk_bool_sort(), m1);
+    expr_ref a(m1.mk_const(symbol("a"), b), m1);
+    expr_ref c(m1.mk_const(symbol("c"), b), m1);
+    expr_ref t1(m1.mk_and(a, c), m1);
+    expr_ref t2(m1.mk_or(t1, a), m1);
+    expr_ref r1(to2(t1.get()), m2);
+    unsigned copied = to2.copied_count();
+    expr_ref r2(to2(t2.get()), m2);
+    // the or node and its declaration
+    ENSURE(to2.copied_count() == copied + 2);
+    ENSURE(to_app(r2)->get_arg(0) == r1);
+    ENSURE(to1(r2.get()) == t2.get());
+    ENSURE(to1.copied_count() == 0);
+}
+
+static void tst9() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    expr_ref a(m.mk_const(symbol("a"), b), m);
+    expr_ref c(m.mk_const(symbol("c"), b), m);
+    unsigned num_asts = m.get_num_asts();
+    expr_ref r(m);
+    {
+        ast_manager::scratch_scope scope(m);
+        expr * t = m.mk_and(a, c);
+        {
+            expr_ref t1(t, m);
+            expr_ref t2(m.mk_not(t1), m);
+        }
+        // unreferenced scratch nodes are kept until the scope is closed
+        ENSURE(m.mk_and(a, c) == t);
+        ENSURE(m.mk_true() == m.mk_true());
+        r = m.mk_or(m.mk_not(a), c);
+        ENSURE(m.get_num_asts() == num_asts + 4);
+    }
+    // the and and not(and) nodes are released, the or and not(a) nodes are promoted
+    ENSURE(m.get_num_asts() == num_asts + 2);
+    ENSURE(m.contains(r));
+    ENSURE(m.mk_or(m.mk_not(a), c) == r.get());
+    r = nullptr;
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
+/**
+   \brief Memory used by the unrolling of a bit-level circuit, in the style of bounded model checking.
+   Each step k computes s_i' = s_i xor (s_{i-1} and in_k) for every state bit s_i.
+*/
+void tst_ast_memory(char** argv, int argc, int& i) {
+    unsigned num_bits = 1000;
+    unsigned num_steps = 1000;
+    if (i + 1 < argc) {
+        num_bits = atoi(argv[i + 1]);
+        i++;
+    }
+    if (i + 1 < argc) {
+        num_steps = atoi(argv[i + 1]);
+        i++;
+    }
+    unsigned long long mem0 = memory::get_allocation_size();
+    stopwatch sw;
+    sw.start();
+    {
+        ast_manager m;
+        sort * b = m.mk_bool_sort();
+        expr_ref_vector state(m), next(m);
+        for (unsigned j = 0; j < num_bits; ++j)
+            state.push_back(m.mk_const(symbol(j), b));
+        for (unsigned k = 0; k < num_steps; ++k) {
+            expr_ref in(m.mk_fresh_const("in", b), m);
+            next.reset();
+            for (unsigned j = 0; j < num_bits; ++j) {
+                expr * carry = j == 0 ? in.get() : m.mk_and(state.get(j - 1), in);
+                next.push_back(m.mk_xor(state.get(j), carry));
+            }
+            state.swap(next);
+        }
+        sw.stop();
+        std::cout << "bits: " << num_bits << " steps: " << num_steps
+                  << " asts: " << m.get_num_asts()
+                  << " sizeof(app): " << sizeof(app)
+                  << " memory: " << (memory::get_allocation_size() - mem0) / (1024 * 1024) << "MB"
+                  << " time: " << sw.get_seconds() << "\n";
+    }
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +323,10 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
+    tst7();
+    tst8();
+    tst9();
+    tst10();
 }
 
@@ -2202,6 +2202,7 @@ void setup_args_parser(argument_parser & parser) {
     parser.add_option_with_help_string("--randomize_lar", "test randomize functionality");
     parser.add_option_with_help_string("--smap", "test stacked_map");
     parser.add_option_with_help_string("--term", "simple term test");
+    parser.add_option_with_help_string("--bound_flips", "repair an infeasible row by bound flips");
     parser.add_option_with_help_string("--eti"," run a small evidence test for total infeasibility scenario");
     parser.add_option_with_help_string("--row_inf", "forces row infeasibility search");
     parser.add_option_with_help_string("-pd", "presolve with double solver");
@@ -2982,6 +2983,34 @@ void test_term() {
     
 }
 
+// x + y >= 20 with x, y in [0, 10] and x = y = 0: the row of x + y is repaired by flipping x and y
+// to their upper bounds, without a pivot.
+void test_bound_flips() {
+    for (bool flips : { false, true }) {
+        lar_solver solver;
+        solver.settings().bound_flips() = flips;
+        unsigned before = solver.settings().stats().m_bound_flips;
+        var_index x = solver.add_var(0, false);
+        var_index y = solver.add_var(1, false);
+        solver.add_var_bound(x, GE, mpq(0));
+        solver.add_var_bound(x, LE, mpq(10));
+        solver.add_var_bound(y, GE, mpq(0));
+        solver.add_var_bound(y, LE, mpq(10));
+        vector<std::pair<mpq, var_index>> ls;
+        ls.push_back(std::pair<mpq, var_index>(mpq(1), x));
+        ls.push_back(std::pair<mpq, var_index>(mpq(1), y));
+        unsigned t = solver.add_term(ls, 2);
+        solver.add_var_bound(t, GE, mpq(20));
+        lp_status st = solver.find_feasible_solution();
+        ENSURE(st == lp_status::OPTIMAL || st == lp_status::FEASIBLE);
+        ENSURE(solver.get_column_value(x) == impq(10));
+        ENSURE(solver.get_column_value(y) == impq(10));
+        ENSURE(solver.ax_is_correct());
+        unsigned num_flips = solver.settings().stats().m_bound_flips - before;
+        ENSURE(flips ? num_flips == 2 : num_flips == 0);
+    }
+}
+
 void test_evidence_for_total_inf_simple(argument_parser & args_parser) {
     lar_solver solver;
     var_index x = solver.add_var(0, false);
@@ -4074,6 +4103,10 @@ void test_lp_local(int argn, char**argv) {
         ret = 0;
         return finalize(ret);
     }
+    if (args_parser.option_is_used("--bound_flips")) {
+        test_bound_flips();
+        return finalize(0);
+    }
     unsigned max_iters;
     unsigned time_limit;
     get_time_limit_and_max_iters_from_parser(args_parser, time_limit, max_iters);
@@ -4112,6 +4145,9 @@ void test_lp_local(int argn, char**argv) {
 void tst_lp(char ** argv, int argc, int& i) {
     lp::test_lp_local(argc - 2, argv + 2);
 }
+void tst_lp_bound_flips() {
+    lp::test_bound_flips();
+}
 #ifdef Z3DEBUG
 namespace lp {
 template void print_matrix<general_matrix>(general_matrix&, std::ostream&);
@@ -203,6 +203,11 @@ int main(int argc, char ** argv) {
     TST(arith_rewriter);
     TST(check_assumptions);
     TST(smt_context);
+    TST(smt_parallel);
+    TST(smt_lemma_glue);
+    TST(lp_bound_flips);
+    TST(smt_bv_lazy_blast);
+    TST(smt_int_bnb);
     TST(theory_dl);
     TST(model_retrieval);
     TST(model_based_opt);
@@ -235,6 +240,10 @@ int main(int argc, char ** argv) {
     TST(karr);
     TST(no_overflow);
     // TST(memory);
+    TST(memory_thread_cache);
+    TST_ARGV(memory_contention);
+    TST_ARGV(symbol_parallel);
+    TST_ARGV(ast_memory);
     TST(datalog_parser);
     TST_ARGV(datalog_parser_file);
     TST(dl_query);
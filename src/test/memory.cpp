@@ -64,3 +64,105 @@ void tst_memory() {
 void tst_memory() {    
 }
 #endif
+
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <iostream>
+#include <cstdlib>
+#include "api/z3.h"
+#include "util/stopwatch.h"
+#include "util/vector.h"
+#include "util/memory_manager.h"
+
+/**
+   \brief contention benchmark for the memory accounting: every thread builds and
+   simplifies terms in its own context.
+*/
+static void memory_contention_worker(unsigned id, unsigned rounds) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_sort bv = Z3_mk_bv_sort(ctx, 32);
+    for (unsigned r = 0; r < rounds; ++r) {
+        Z3_ast t = Z3_mk_unsigned_int(ctx, id, bv);
+        for (unsigned i = 0; i < 200; ++i) {
+            Z3_ast x = Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, i), bv);
+            t = Z3_mk_bvadd(ctx, Z3_mk_bvmul(ctx, t, x), Z3_mk_unsigned_int(ctx, i + r, bv));
+        }
+        Z3_inc_ref(ctx, t);
+        Z3_ast s = Z3_simplify(ctx, t);
+        Z3_inc_ref(ctx, s);
+        Z3_dec_ref(ctx, s);
+        Z3_dec_ref(ctx, t);
+    }
+    Z3_del_context(ctx);
+}
+
+void tst_memory_contention(char** argv, int argc, int& i) {
+    unsigned num_threads = std::max(2u, std::thread::hardware_concurrency());
+    unsigned rounds = 200;
+    if (i + 1 < argc) {
+        num_threads = atoi(argv[i + 1]);
+        i++;
+    }
+    if (i + 1 < argc) {
+        rounds = atoi(argv[i + 1]);
+        i++;
+    }
+    stopwatch sw;
+    sw.start();
+    vector<std::thread> threads;
+    for (unsigned id = 0; id < num_threads; ++id)
+        threads.push_back(std::thread([id, rounds]() { memory_contention_worker(id, rounds); }));
+    for (std::thread& t : threads)
+        t.join();
+    sw.stop();
+    std::cout << "threads: " << num_threads << " rounds: " << rounds
+              << " time: " << sw.get_seconds()
+              << " allocations: " << memory::get_allocation_count()
+              << " max. memory: " << memory::get_max_used_memory() << "\n";
+}
+
+#if defined(_WINDOWS) || defined(_USE_THREAD_LOCAL)
+/**
+   \brief allocate and free small blocks on a worker thread and check the per thread
+   allocation counter and, if enabled, the reuse of freed blocks by the thread cache.
+*/
+static void memory_thread_cache_worker(bool cache) {
+    const unsigned n = 100;
+    void * blocks[n];
+    uint64_t base = Z3_get_thread_alloc_size();
+    unsigned long long hits = memory::get_thread_cache_hits();
+    for (unsigned round = 0; round < 2; ++round) {
+        for (unsigned i = 0; i < n; ++i)
+            blocks[i] = memory::allocate(40);
+        ENSURE(Z3_get_thread_alloc_size() >= base + n * 40);
+        for (unsigned i = 0; i < n; ++i)
+            memory::deallocate(blocks[i]);
+        ENSURE(Z3_get_thread_alloc_size() == base);
+    }
+    // the cache of a new thread is empty, so only the blocks of the second round are reused
+    ENSURE(memory::get_thread_cache_hits() - hits == (cache ? n : 0));
+}
+
+void tst_memory_thread_cache() {
+    for (bool cache : { false, true }) {
+        memory::set_thread_cache(cache);
+        uint64_t base = Z3_get_thread_alloc_size();
+        std::thread t([cache]() { memory_thread_cache_worker(cache); });
+        t.join();
+        ENSURE(Z3_get_thread_alloc_size() == base);
+    }
+    memory::set_thread_cache(false);
+}
+#else
+// the memory manager keeps no per thread counters or caches
+void tst_memory_thread_cache() {
+}
+#endif
+#else
+void tst_memory_contention(char** argv, int argc, int& i) {
+}
+void tst_memory_thread_cache() {
+}
+#endif
@@ -503,8 +503,157 @@ static void tst_pw2() {
     }
 }
 
+#ifdef _MPZ_INT128
+typedef unsigned __int128 u128;
+
+static u128 mk_u128(uint64_t hi, uint64_t lo) {
+    return (static_cast<u128>(hi) << 64) | lo;
+}
+
+// absolute values around the limits of int, 64 and 128 bits
+static void u128_samples(vector<u128> & vs) {
+    uint64_t const m = UINT64_MAX;
+    u128 const samples[] = {
+        0, 1, 2, 3, INT_MAX, static_cast<u128>(INT_MAX) + 1, UINT_MAX, static_cast<u128>(UINT_MAX) + 1,
+        static_cast<u128>(INT64_MAX) - 1, INT64_MAX, static_cast<u128>(INT64_MAX) + 1, m - 1, m,
+        mk_u128(1, 0), mk_u128(1, 1), mk_u128(0x3fffffffffffffffull, m), mk_u128(0x4000000000000000ull, 0),
+        mk_u128(INT64_MAX, m), mk_u128(0x8000000000000000ull, 0), mk_u128(m, m - 1), mk_u128(m, m),
+        mk_u128(0x123456789abcdefull, 0xfedcba9876543210ull), mk_u128(0, 0xfedcba9876543210ull)
+    };
+    for (u128 v : samples)
+        vs.push_back(v);
+}
+
+// v from its 32-bit digits, without the 128-bit fast paths
+template<bool SYNCH>
+static void mk_generic(mpz_manager<SYNCH> & m, int sign, u128 v, mpz & r) {
+    _scoped_numeral<mpz_manager<SYNCH>> d(m), t(m);
+    m.set(r, 0);
+    for (int i = 3; i >= 0; --i) {
+        m.mul2k(r, 32);
+        m.set(d, static_cast<uint64_t>(static_cast<uint32_t>(v >> (32 * i))));
+        m.bitwise_or(r, d, t);
+        m.set(r, t);
+    }
+    if (sign < 0)
+        m.neg(r);
+}
+
+template<bool SYNCH>
+static void tst_u128_conversions() {
+    mpz_manager<SYNCH> m;
+    vector<u128> vs;
+    u128_samples(vs);
+    _scoped_numeral<mpz_manager<SYNCH>> a(m), b(m);
+    for (u128 v : vs) {
+        for (int sign : { 1, -1 }) {
+            m.set_u128(a, sign, v);
+            mk_generic(m, sign, v, b);
+            ENSURE(m.eq(a, b));
+            ENSURE(m.is_small(a) == m.is_small(b));
+            int s;
+            u128 w;
+            ENSURE(m.get_u128(a, s, w));
+            ENSURE(w == v);
+            ENSURE(v == 0 || s == sign);
+        }
+    }
+    // numbers that do not fit in 128 bits
+    m.set_u128(a, 1, mk_u128(UINT64_MAX, UINT64_MAX));
+    m.add(a, mpz(1), b);
+    int s;
+    u128 w;
+    ENSURE(!m.get_u128(b, s, w));
+    m.neg(b);
+    ENSURE(!m.get_u128(b, s, w));
+}
+
+static u128 euclid_gcd(u128 u, u128 v) {
+    while (v != 0) {
+        u128 r = u % v;
+        u = v;
+        v = r;
+    }
+    return u;
+}
+
+static void tst_u128_gcd() {
+    vector<u128> vs;
+    u128_samples(vs);
+    for (u128 u : vs) 
+        for (u128 v : vs) 
+            ENSURE(u128_gcd(u, v) == euclid_gcd(u, v));
+    u128 g = mk_u128(0, 0x123456789ull);
+    ENSURE(u128_gcd(g * 0xfffffffbull, g * mk_u128(1, 7)) == g * euclid_gcd(0xfffffffbull, mk_u128(1, 7)));
+    ENSURE(u128_gcd(mk_u128(1, 0) << 60, mk_u128(1, 0) << 3) == mk_u128(1, 0) << 3);
+}
+
+/**
+   \brief compare add, sub, mul, div, rem and gcd on operands of at most 128 bits with
+   the generic path, reached by scaling the operands with a number of more than 128 bits.
+*/
+template<bool SYNCH>
+static void tst_u128_fast_paths() {
+    mpz_manager<SYNCH> m;
+    vector<u128> vs;
+    u128_samples(vs);
+    _scoped_numeral<mpz_manager<SYNCH>> a(m), b(m), c(m), big(m), sa(m), sb(m), sc(m), t(m);
+    m.set(big, "1606938044258990275541962092341162602522202993782792835301377"); // 2^200 + 1
+    for (u128 va : vs) {
+        for (u128 vb : vs) {
+            for (int sign_a : { 1, -1 }) {
+                for (int sign_b : { 1, -1 }) {
+                    m.set_u128(a, sign_a, va);
+                    m.set_u128(b, sign_b, vb);
+                    m.mul(a, big, sa);
+                    m.mul(b, big, sb);
+
+                    m.add(a, b, c);
+                    m.add(sa, sb, sc);
+                    m.mul(c, big, t);
+                    ENSURE(m.eq(t, sc));
+
+                    m.sub(a, b, c);
+                    m.sub(sa, sb, sc);
+                    m.mul(c, big, t);
+                    ENSURE(m.eq(t, sc));
+
+                    m.mul(a, b, c);
+                    m.mul(sa, b, sc);
+                    m.mul(c, big, t);
+                    ENSURE(m.eq(t, sc));
+
+                    m.gcd(a, b, c);
+                    m.gcd(sa, sb, sc);
+                    m.mul(c, big, t);
+                    ENSURE(m.eq(t, sc));
+
+                    if (vb == 0)
+                        continue;
+                    m.machine_div(a, b, c);
+                    m.machine_div(sa, sb, sc);
+                    ENSURE(m.eq(c, sc));
+
+                    m.rem(a, b, c);
+                    m.rem(sa, sb, sc);
+                    m.mul(c, big, t);
+                    ENSURE(m.eq(t, sc));
+                }
+            }
+        }
+    }
+}
+#endif
+
 void tst_mpz() {
     disable_trace("mpz");
+#ifdef _MPZ_INT128
+    tst_u128_conversions<true>();
+    tst_u128_conversions<false>();
+    tst_u128_gcd();
+    tst_u128_fast_paths<true>();
+    tst_u128_fast_paths<false>();
+#endif
     enable_trace("mpz_2k");
     tst_pw2();
     tst5();
@@ -556,6 +556,16 @@ static void tst_resultant() {
     tst_resultant((x^2) + 2*x + 1, n1, max_var(x), n2);
     tst_resultant(2*x + 1, n1, max_var(x), n1);
     tst_resultant((x^2) + 8*x + 1, n1, max_var(x), n2);
+    // univariate resultants with big coefficients are computed modulo primes below 2^31
+    polynomial_ref A(m), B(m), C(m), P(m);
+    A = m.mk_const(power(rational(2), 130) + rational(7));
+    B = m.mk_const(power(rational(3), 90) - rational(5));
+    C = m.mk_const(power(rational(5), 70) + rational(1));
+    P = m.mk_const(rational(2147483647) * rational(2147483629)); // leading coefficient vanishes modulo the first primes
+    tst_resultant((x - A)*(x - B), x - C, max_var(x), (C - A)*(C - B));
+    tst_resultant((x^2) - A*a, x - B*a, max_var(x), (B^2)*(a^2) - A*a);
+    tst_resultant(P*(x^2) + A*x + 1, x - C, max_var(x), P*(C^2) + A*C + 1);
+    tst_resultant(x - C, P*(x^2) + A*b*x + B, max_var(x), P*(C^2) + A*b*C + B);
 }
 
 static void tst_compose() {
@@ -5,7 +5,11 @@ Copyright (c) 2015 Microsoft Corporation
 --*/
 
 #include "smt/smt_context.h"
+#include "smt/smt_parallel.h"
 #include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
 
 void tst_smt_context()
 {
@@ -33,3 +37,222 @@ void tst_smt_context()
 
     ctx.check();
 }
+
+static void add_pigeon_hole(ast_manager& m, unsigned n, expr_ref_vector& fmls) {
+    // n + 1 pigeons, n holes
+    expr_ref_vector ps(m);
+    for (unsigned i = 0; i <= n; ++i)
+        for (unsigned j = 0; j < n; ++j)
+            ps.push_back(m.mk_const(symbol((std::string("p") + std::to_string(i) + "_" + std::to_string(j)).c_str()), m.mk_bool_sort()));
+    for (unsigned i = 0; i <= n; ++i)
+        fmls.push_back(m.mk_or(n, ps.c_ptr() + i * n));
+    for (unsigned j = 0; j < n; ++j)
+        for (unsigned i = 0; i <= n; ++i)
+            for (unsigned k = i + 1; k <= n; ++k)
+                fmls.push_back(m.mk_not(m.mk_and(ps.get(i * n + j), ps.get(k * n + j))));
+}
+
+static void add_random_3sat(ast_manager& m, unsigned num_vars, unsigned num_clauses, unsigned seed, expr_ref_vector& fmls) {
+    random_gen rand(seed);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i < num_vars; ++i)
+        xs.push_back(m.mk_const(symbol((std::string("x") + std::to_string(i)).c_str()), m.mk_bool_sort()));
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        expr_ref_vector lits(m);
+        for (unsigned j = 0; j < 3; ++j) {
+            expr* x = xs.get(rand(num_vars));
+            lits.push_back(rand(2) ? x : m.mk_not(x));
+        }
+        fmls.push_back(m.mk_or(lits));
+    }
+}
+
+static lbool check_parallel(ast_manager& m, expr_ref_vector const& fmls, unsigned share_size) {
+    smt_params params;
+    params.m_threads = 2;
+    params.m_threads_share_size = share_size;
+    smt::context ctx(m, params);
+    for (expr* f : fmls)
+        ctx.assert_expr(f);
+    smt::parallel p(ctx);
+    expr_ref_vector asms(m);
+    lbool r = p(asms);
+    ENSURE(p.check_shared_atoms());
+    return r;
+}
+
+void tst_smt_parallel() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    {
+        expr_ref_vector fmls(m);
+        add_pigeon_hole(m, 6, fmls);
+        ENSURE(check_parallel(m, fmls, 0) == l_false);
+        ENSURE(check_parallel(m, fmls, 8) == l_false);
+    }
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        expr_ref_vector fmls(m);
+        add_random_3sat(m, 120, 510, seed, fmls);
+        lbool r = check_parallel(m, fmls, 0);
+        ENSURE(r != l_undef);
+        ENSURE(check_parallel(m, fmls, 8) == r);
+    }
+}
+
+static unsigned get_stat(smt::context& ctx, char const* key) {
+    statistics st;
+    ctx.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static lbool check_php(ast_manager& m, smt_params& params, unsigned n, unsigned& restarts, unsigned& deleted) {
+    expr_ref_vector fmls(m);
+    add_pigeon_hole(m, n, fmls);
+    smt::context ctx(m, params);
+    for (expr* f : fmls)
+        ctx.assert_expr(f);
+    lbool r = ctx.check();
+    restarts = get_stat(ctx, "restarts");
+    deleted = get_stat(ctx, "lemma del tier2") + get_stat(ctx, "lemma del local");
+    return r;
+}
+
+void tst_smt_lemma_glue() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    unsigned restarts = 0, deleted = 0;
+    {
+        // tiered lemma garbage collection
+        smt_params params;
+        params.m_lemma_gc_tiered = true;
+        params.m_lemma_gc_initial = 100;
+        params.m_recent_lemmas_size = 10;
+        ENSURE(check_php(m, params, 7, restarts, deleted) == l_false);
+        ENSURE(deleted > 0);
+    }
+    {
+        // restarts driven by moving averages of the glue of learned clauses
+        smt_params params;
+        params.m_restart_strategy = RS_EMA;
+        params.m_restart_adaptive = false;
+        params.m_restart_initial = 10;
+        params.m_restart_fast_glue_avg = 0.1;
+        params.m_restart_slow_glue_avg = 0.001;
+        ENSURE(check_php(m, params, 7, restarts, deleted) == l_false);
+        ENSURE(restarts > 0);
+    }
+}
+
+static lbool check_bv(ast_manager& m, expr_ref_vector const& fmls, unsigned lazy_blast, unsigned& lazy_terms) {
+    smt_params params;
+    params.m_bv_lazy_blast = lazy_blast;
+    smt::context ctx(m, params);
+    for (expr* f : fmls)
+        ctx.assert_expr(f);
+    lbool r = ctx.check();
+    lazy_terms = get_stat(ctx, "bv lazy terms");
+    if (r == l_true) {
+        model_ref mdl;
+        ctx.get_model(mdl);
+        for (expr* f : fmls)
+            ENSURE(mdl->is_true(f));
+    }
+    return r;
+}
+
+void tst_smt_bv_lazy_blast() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    sort_ref s(bv.mk_sort(8), m);
+    expr_ref x(m.mk_const(symbol("x"), s), m);
+    expr_ref y(m.mk_const(symbol("y"), s), m);
+    expr_ref one(bv.mk_numeral(1, 8), m), two(bv.mk_numeral(2, 8), m);
+    expr_ref_vector sat(m), unsat1(m), unsat2(m), unsat3(m);
+
+    // sat: x * y = 0x52, 1 < y and x / y = 2, e.g. x = 26, y = 13
+    sat.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(0x52, 8)));
+    sat.push_back(m.mk_not(bv.mk_ule(y, one)));
+    sat.push_back(m.mk_eq(bv.mk_bv_udiv(x, y), two));
+
+    // unsat: no square is 2 modulo 256
+    unsat1.push_back(m.mk_eq(bv.mk_bv_mul(x, x), two));
+    // unsat: 2 has no multiplicative inverse
+    unsat2.push_back(m.mk_eq(bv.mk_bv_mul(x, two), one));
+    // unsat: unsigned division by a non-zero value does not grow
+    unsat3.push_back(m.mk_not(m.mk_eq(y, bv.mk_numeral(0, 8))));
+    unsat3.push_back(m.mk_not(bv.mk_ule(bv.mk_bv_udiv(x, y), x)));
+
+    std::pair<expr_ref_vector*, lbool> cases[] = {
+        { &sat, l_true }, { &unsat1, l_false }, { &unsat2, l_false }, { &unsat3, l_false }
+    };
+    for (auto const& c : cases) {
+        unsigned eager_terms = 0, lazy_terms = 0;
+        lbool eager = check_bv(m, *c.first, 0, eager_terms);
+        lbool lazy = check_bv(m, *c.first, 4, lazy_terms);
+        ENSURE(eager == c.second);
+        ENSURE(lazy == eager);
+        ENSURE(eager_terms == 0);
+        ENSURE(lazy_terms > 0);
+    }
+}
+
+// c1 * x = 500, c2 * x = 520, 0 <= x <= 10 over n integer variables
+static lbool check_int_bnb(ast_manager& m, unsigned threads, unsigned n, int const* c1, int const* c2, vector<rational>& vals, unsigned& bnb_calls) {
+    arith_util a(m);
+    smt_params fparams;
+    params_ref p;
+    p.set_uint("arith.bnb.threads", threads);
+    smt::context ctx(m, fparams, p);
+    expr_ref_vector xs(m), t1(m), t2(m);
+    for (unsigned i = 0; i < n; ++i) {
+        expr* x = m.mk_const(symbol(i), a.mk_int());
+        xs.push_back(x);
+        t1.push_back(a.mk_mul(a.mk_int(c1[i]), x));
+        t2.push_back(a.mk_mul(a.mk_int(c2[i]), x));
+        ctx.assert_expr(a.mk_ge(x, a.mk_int(0)));
+        ctx.assert_expr(a.mk_le(x, a.mk_int(10)));
+    }
+    ctx.assert_expr(m.mk_eq(a.mk_add(t1.size(), t1.c_ptr()), a.mk_int(500)));
+    ctx.assert_expr(m.mk_eq(a.mk_add(t2.size(), t2.c_ptr()), a.mk_int(520)));
+    lbool r = ctx.check();
+    bnb_calls = get_stat(ctx, "arith-bnb-calls");
+    vals.reset();
+    if (r == l_true) {
+        model_ref mdl;
+        ctx.get_model(mdl);
+        for (expr* x : xs) {
+            expr_ref v(m);
+            rational val;
+            bool is_int;
+            ENSURE(mdl->eval_expr(x, v, true) && a.is_numeral(v, val, is_int));
+            vals.push_back(val);
+        }
+        rational s1, s2;
+        for (unsigned i = 0; i < n; ++i) {
+            ENSURE(vals[i].is_int() && !vals[i].is_neg() && vals[i] <= 10);
+            s1 += c1[i] * vals[i];
+            s2 += c2[i] * vals[i];
+        }
+        ENSURE(s1 == 500 && s2 == 520);
+    }
+    return r;
+}
+
+void tst_smt_int_bnb() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    vector<rational> vals;
+    unsigned calls = 0;
+    int const sat_c1[4] = { 35, 39, 26, 45 }, sat_c2[4] = { 50, 29, 25, 24 };
+    int const unsat_c1[5] = { 23, 25, 25, 43, 30 }, unsat_c2[5] = { 39, 36, 58, 33, 58 };
+    for (unsigned threads : { 0, 1, 2, 4 }) {
+        ENSURE(check_int_bnb(m, threads, 4, sat_c1, sat_c2, vals, calls) == l_true);
+        ENSURE((threads == 0) == (calls == 0));
+        ENSURE(check_int_bnb(m, threads, 5, unsat_c1, unsat_c2, vals, calls) == l_false);
+        ENSURE((threads == 0) == (calls == 0));
+    }
+}
@@ -55,5 +55,62 @@ void tst_symbol() {
     tst1();
 }
 
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include "api/z3.h"
+#include "util/stopwatch.h"
+#include "util/vector.h"
 
+// Each thread parses the same SMT-LIB2 script in its own context.
+// All contexts share the global symbol table.
+static void symbol_parallel_worker(std::string const& script, unsigned rounds) {
+    for (unsigned r = 0; r < rounds; ++r) {
+        Z3_config cfg = Z3_mk_config();
+        Z3_context ctx = Z3_mk_context(cfg);
+        Z3_del_config(cfg);
+        Z3_ast_vector v = Z3_parse_smtlib2_string(ctx, script.c_str(), 0, nullptr, nullptr, 0, nullptr, nullptr);
+        ENSURE(Z3_ast_vector_size(ctx, v) > 0);
+        Z3_del_context(ctx);
+    }
+}
+
+static void symbol_parallel_run(std::string const& script, unsigned num_threads, unsigned rounds) {
+    stopwatch sw;
+    sw.start();
+    vector<std::thread> threads;
+    for (unsigned id = 0; id < num_threads; ++id)
+        threads.push_back(std::thread([&script, rounds]() { symbol_parallel_worker(script, rounds); }));
+    for (std::thread& t : threads)
+        t.join();
+    sw.stop();
+    std::cout << "threads: " << num_threads << " rounds: " << rounds << " time: " << sw.get_seconds() << "\n";
+}
 
+void tst_symbol_parallel(char** argv, int argc, int& i) {
+    unsigned num_threads = std::max(2u, std::thread::hardware_concurrency());
+    unsigned rounds = 20;
+    unsigned num_decls = 2000;
+    if (i + 1 < argc) {
+        num_threads = atoi(argv[i + 1]);
+        i++;
+    }
+    if (i + 1 < argc) {
+        rounds = atoi(argv[i + 1]);
+        i++;
+    }
+    std::string script;
+    for (unsigned j = 0; j < num_decls; ++j)
+        script += "(declare-const x_" + std::to_string(j) + " Int)\n";
+    for (unsigned j = 0; j + 1 < num_decls; ++j)
+        script += "(assert (< x_" + std::to_string(j) + " x_" + std::to_string(j + 1) + "))\n";
+    // the single threaded run is the baseline for the scaling
+    for (unsigned n = 1; n < num_threads; n *= 2)
+        symbol_parallel_run(script, n, rounds);
+    symbol_parallel_run(script, num_threads, rounds);
+}
+#else
+void tst_symbol_parallel(char** argv, int argc, int& i) {
+}
+#endif
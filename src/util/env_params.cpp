@@ -29,6 +29,7 @@ void env_params::updt_params() {
     memory::set_max_size(megabytes_to_bytes(p.get_uint("memory_max_size", 0)));
     memory::set_max_alloc_count(p.get_uint("memory_max_alloc_count", 0));
     memory::set_high_watermark(p.get_uint("memory_high_watermark", 0));
+    memory::set_thread_cache(p.get_bool("memory_thread_cache", false));
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -37,4 +38,5 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_size", CPK_UINT, "set hard upper limit for memory consumption (in megabytes), if 0 then there is no limit", "0");
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("memory_thread_cache", CPK_BOOL, "cache freed small blocks in thread local free lists before returning them to the system allocator", "false");
 }
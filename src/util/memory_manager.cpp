@@ -36,15 +36,18 @@ out_of_memory_error::out_of_memory_error():z3_error(ERR_MEMOUT) {
 }
 
 
-static DECLARE_INIT_MUTEX(g_memory_mux);
+// The global counters are updated without locks. Threads batch their updates
+// in thread local counters (see synchronize_counters), so the global size lags
+// behind the real size by less than SYNCH_THRESHOLD bytes per thread.
 static atomic<bool> g_memory_out_of_memory(false);
 static bool       g_memory_initialized       = false;
-static long long  g_memory_alloc_size        = 0;
+static atomic<long long> g_memory_alloc_size(0);
 static long long  g_memory_max_size          = 0;
-static long long  g_memory_max_used_size     = 0;
+static atomic<long long> g_memory_max_used_size(0);
 static long long  g_memory_watermark         = 0;
-static long long  g_memory_alloc_count       = 0;
+static atomic<long long> g_memory_alloc_count(0);
 static long long  g_memory_max_alloc_count   = 0;
+static atomic<bool> g_memory_thread_cache(false);
 static bool       g_exit_when_out_of_memory  = false;
 static char const * g_out_of_memory_msg      = "ERROR: out of memory";
 
@@ -71,6 +74,32 @@ static void throw_alloc_counts_exceeded() {
     exit(ERR_ALLOC_EXCEEDED);
 }
 
+static void update_max_used_size(long long sz) {
+#ifdef SINGLE_THREAD
+    if (sz > g_memory_max_used_size)
+        g_memory_max_used_size = sz;
+#else
+    long long old_sz = g_memory_max_used_size;
+    while (sz > old_sz && !g_memory_max_used_size.compare_exchange_weak(old_sz, sz))
+        ;
+#endif
+}
+
+/**
+   \brief add the given deltas to the global counters and check the limits.
+*/
+static void update_counters(long long size_delta, long long count_delta, bool allocating) {
+    long long sz    = (g_memory_alloc_size += size_delta);
+    long long count = (g_memory_alloc_count += count_delta);
+    update_max_used_size(sz);
+    if (!allocating)
+        return;
+    if (g_memory_max_size != 0 && sz > g_memory_max_size)
+        throw_out_of_memory();
+    if (g_memory_max_alloc_count != 0 && count > g_memory_max_alloc_count)
+        throw_alloc_counts_exceeded();
+}
+
 
 #ifdef PROFILE_MEMORY
 static unsigned g_synch_counter = 0;
@@ -114,7 +143,6 @@ void memory::set_high_watermark(size_t watermark) {
 bool memory::above_high_watermark() {
     if (g_memory_watermark == 0)
         return false;
-    lock_guard lock(*g_memory_mux);
     return g_memory_watermark < g_memory_alloc_size;
 }
 
@@ -129,15 +157,16 @@ void memory::set_max_alloc_count(size_t max_count) {
     g_memory_max_alloc_count = max_count;
 }
 
+void memory::set_thread_cache(bool enable) {
+    g_memory_thread_cache = enable;
+}
+
 static bool g_finalizing = false;
 
 void memory::finalize(bool shutdown) {
     if (g_memory_initialized) {
         g_finalizing = true;
         mem_finalize();
-        // we leak the mutex since we need it to be always live since memory may
-        // be reinitialized again
-        //delete g_memory_mux;
         g_memory_initialized = false;
         g_finalizing = false;
 
@@ -148,23 +177,14 @@ void memory::finalize(bool shutdown) {
 }
 
 unsigned long long memory::get_allocation_size() {
-    long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_alloc_size;
-    }
+    long long r = g_memory_alloc_size;
     if (r < 0)
         r = 0;
     return r;
 }
 
 unsigned long long memory::get_max_used_memory() {
-    unsigned long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_max_used_size;
-    }
-    return r;
+    return g_memory_max_used_size;
 }
 
 #if defined(_WINDOWS)
@@ -229,32 +249,80 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 
 thread_local long long g_memory_thread_alloc_size    = 0;
 thread_local long long g_memory_thread_alloc_count   = 0;
+// bytes allocated minus bytes freed by the current thread
+thread_local long long g_memory_thread_live_size     = 0;
+thread_local long long g_memory_thread_cache_hits    = 0;
+
+// Optional cache of freed small blocks in front of malloc and free (see memory::set_thread_cache).
+// A thread caches the blocks it frees, no matter which thread allocated them, so frees
+// of blocks owned by other threads need no synchronization. Blocks are grouped in size
+// classes of CACHE_GRANULARITY bytes, and a class holds at most CACHE_MAX_BLOCKS blocks,
+// so a thread caches less than CACHE_NUM_CLASSES * CACHE_MAX_BLOCKS * CACHE_MAX_SIZE bytes.
+#define CACHE_GRANULARITY 16
+#define CACHE_NUM_CLASSES 17
+#define CACHE_MAX_SIZE    (CACHE_GRANULARITY * (CACHE_NUM_CLASSES - 1))
+#define CACHE_MAX_BLOCKS  128
+
+class thread_block_cache {
+    void *   m_free[CACHE_NUM_CLASSES];  // free lists linked through the first word of the blocks
+    unsigned m_size[CACHE_NUM_CLASSES];
+public:
+    thread_block_cache() {
+        for (unsigned c = 0; c < CACHE_NUM_CLASSES; ++c) {
+            m_free[c] = nullptr;
+            m_size[c] = 0;
+        }
+    }
+
+    ~thread_block_cache() {
+        for (unsigned c = 0; c < CACHE_NUM_CLASSES; ++c) {
+            while (m_free[c]) {
+                void * next = *static_cast<void**>(m_free[c]);
+                free(m_free[c]);
+                m_free[c] = next;
+            }
+        }
+    }
+
+    void * pop(unsigned c) {
+        void * r = m_free[c];
+        if (r) {
+            m_free[c] = *static_cast<void**>(r);
+            --m_size[c];
+        }
+        return r;
+    }
+
+    bool push(unsigned c, void * p) {
+        if (c == 0 || m_size[c] >= CACHE_MAX_BLOCKS)
+            return false;
+        *static_cast<void**>(p) = m_free[c];
+        m_free[c] = p;
+        ++m_size[c];
+        return true;
+    }
+};
+
+thread_local thread_block_cache g_thread_block_cache;
+
+unsigned long long memory::get_thread_allocation_size() {
+    return g_memory_thread_live_size < 0 ? 0 : g_memory_thread_live_size;
+}
+
+unsigned long long memory::get_thread_cache_hits() {
+    return g_memory_thread_cache_hits;
+}
 
 static void synchronize_counters(bool allocating) {
 #ifdef PROFILE_MEMORY
     g_synch_counter++;
 #endif
 
-    bool out_of_mem = false;
-    bool counts_exceeded = false;
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += g_memory_thread_alloc_size;
-        g_memory_alloc_count += g_memory_thread_alloc_count;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            out_of_mem = true;
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            counts_exceeded = true;
-    }
-    g_memory_thread_alloc_size = 0;
-    if (out_of_mem && allocating) {
-        throw_out_of_memory();
-    }
-    if (counts_exceeded && allocating) {
-        throw_alloc_counts_exceeded();
-    }
+    long long size_delta  = g_memory_thread_alloc_size;
+    long long count_delta = g_memory_thread_alloc_count;
+    g_memory_thread_alloc_size  = 0;
+    g_memory_thread_alloc_count = 0;
+    update_counters(size_delta, count_delta, allocating);
 }
 
 void memory::deallocate(void * p) {
@@ -262,7 +330,10 @@ void memory::deallocate(void * p) {
     size_t sz      = *sz_p;
     void * real_p  = reinterpret_cast<void*>(sz_p);
     g_memory_thread_alloc_size -= sz;
-    free(real_p);
+    g_memory_thread_live_size -= sz;
+    // a block of sz bytes can serve any request of its size class sz / CACHE_GRANULARITY
+    if (!g_memory_thread_cache || sz > CACHE_MAX_SIZE || !g_thread_block_cache.push(static_cast<unsigned>(sz / CACHE_GRANULARITY), real_p))
+        free(real_p);
     if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
         synchronize_counters(false);
     }
@@ -270,13 +341,23 @@ void memory::deallocate(void * p) {
 
 void * memory::allocate(size_t s) {
     s = s + sizeof(size_t); // we allocate an extra field!
-    void * r = malloc(s);
+    void * r = nullptr;
+    if (g_memory_thread_cache && s <= CACHE_MAX_SIZE) {
+        unsigned c = static_cast<unsigned>((s + CACHE_GRANULARITY - 1) / CACHE_GRANULARITY);
+        s = c * CACHE_GRANULARITY;
+        r = g_thread_block_cache.pop(c);
+        if (r)
+            ++g_memory_thread_cache_hits;
+    }
+    if (r == nullptr)
+        r = malloc(s);
     if (r == 0) {
         throw_out_of_memory();
         return nullptr;
     }
     *(static_cast<size_t*>(r)) = s;
     g_memory_thread_alloc_size += s;
+    g_memory_thread_live_size += s;
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
         synchronize_counters(true);
@@ -292,6 +373,7 @@ void* memory::reallocate(void *p, size_t s) {
     s = s + sizeof(size_t); // we allocate an extra field!
 
     g_memory_thread_alloc_size += s - sz;
+    g_memory_thread_live_size += s - sz;
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
         synchronize_counters(true);
@@ -313,31 +395,27 @@ void* memory::reallocate(void *p, size_t s) {
 // ==================================
 // ==================================
 // allocate & deallocate without using thread local storage
+// there is no thread cache, so memory::set_thread_cache has no effect.
+
+unsigned long long memory::get_thread_allocation_size() {
+    return get_allocation_size();
+}
+
+unsigned long long memory::get_thread_cache_hits() {
+    return 0;
+}
 
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
     size_t sz      = *sz_p;
     void * real_p  = reinterpret_cast<void*>(sz_p);
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size -= sz;
-    }
+    g_memory_alloc_size -= sz;
     free(real_p);
 }
 
 void * memory::allocate(size_t s) {
     s = s + sizeof(size_t); // we allocate an extra field!
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += s;
-        g_memory_alloc_count += 1;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            throw_out_of_memory();
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            throw_alloc_counts_exceeded();
-    }
+    update_counters(s, 1, true);
     void * r = malloc(s);
     if (r == nullptr) {
         throw_out_of_memory();
@@ -352,17 +430,7 @@ void* memory::reallocate(void *p, size_t s) {
     size_t sz      = *sz_p;
     void * real_p  = reinterpret_cast<void*>(sz_p);
     s = s + sizeof(size_t); // we allocate an extra field!
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += s - sz;
-        g_memory_alloc_count += 1;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            throw_out_of_memory();
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            throw_alloc_counts_exceeded();
-    }
+    update_counters(static_cast<long long>(s) - static_cast<long long>(sz), 1, true);
     void *r = realloc(real_p, s);
     if (r == nullptr) {
         throw_out_of_memory();
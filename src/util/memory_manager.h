@@ -55,6 +55,10 @@ public:
     static bool above_high_watermark();
     static void set_max_size(size_t max_size);
     static void set_max_alloc_count(size_t max_count);
+    /**
+       \brief enable a thread local cache of freed small blocks in front of malloc.
+    */
+    static void set_thread_cache(bool enable);
     static void finalize(bool shutdown = true);
     static void display_max_usage(std::ostream& os);
     static void display_i_max_usage(std::ostream& os);
@@ -68,6 +72,11 @@ public:
     static unsigned long long get_allocation_size();
     static unsigned long long get_max_used_memory();
     static unsigned long long get_allocation_count();
+    /**
+       \brief bytes allocated minus bytes freed by the current thread.
+    */
+    static unsigned long long get_thread_allocation_size();
+    static unsigned long long get_thread_cache_hits();
     static unsigned long long get_max_memory_size();
     // temporary hack to avoid out-of-memory crash in z3.exe
     static void exit_when_out_of_memory(bool flag, char const * msg);
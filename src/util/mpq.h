@@ -690,6 +690,16 @@ public:
         set(a.m_den, d);
         normalize(a);
     }
+
+    /**
+       \brief Set a to n/d where n and d are already coprime and d > 0.
+    */
+    void set_normalized(mpq & a, int64_t n, uint64_t d) {
+        SASSERT(d != 0);
+        set(a.m_num, n);
+        set(a.m_den, d);
+        DEBUG_CODE(mpz g; gcd(a.m_num, a.m_den, g); SASSERT(is_one(g)); del(g););
+    }
     
     void set(mpq & a, mpz const & n, mpz const & d) {
         if (is_neg(d)) {
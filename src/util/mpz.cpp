@@ -122,7 +122,28 @@ uint64_t u64_gcd(uint64_t u, uint64_t v) {
     return u << shift;
 }
 
+#ifdef _MPZ_INT128
+static unsigned u128_trailing_zeros(unsigned __int128 v) {
+    uint64_t lo = static_cast<uint64_t>(v);
+    return lo != 0 ? _trailing_zeros64(lo) : 64 + _trailing_zeros64(static_cast<uint64_t>(v >> 64));
+}
 
+unsigned __int128 u128_gcd(unsigned __int128 u, unsigned __int128 v) {
+    if (u == 0) return v;
+    if (v == 0) return u;
+    if ((u >> 64) == 0 && (v >> 64) == 0)
+        return u64_gcd(static_cast<uint64_t>(u), static_cast<uint64_t>(v));
+    auto shift = u128_trailing_zeros(u | v);
+    u >>= u128_trailing_zeros(u);
+    do {
+        v >>= u128_trailing_zeros(v);
+        if (u > v) std::swap(u, v);
+        v -= u;
+    }
+    while (v != 0);
+    return u << shift;
+}
+#endif
 
 template<bool SYNCH>
 mpz_manager<SYNCH>::mpz_manager():
@@ -187,6 +208,27 @@ mpz_manager<SYNCH>::~mpz_manager() {
 }
 
 #ifndef _MP_GMP
+#ifndef SINGLE_THREAD
+namespace {
+    /**
+       \brief Per-thread cache of freed cells with the initial capacity.
+       Synchronized managers allocate cells using memory::allocate;
+       the cache avoids a round trip to the allocator for short-lived numbers.
+    */
+    struct mpz_cell_cache {
+        static const unsigned max_size = 64;
+        unsigned m_capacity { 0 };
+        unsigned m_size { 0 };
+        void *   m_cells[max_size];
+        ~mpz_cell_cache() {
+            while (m_size > 0)
+                memory::deallocate(m_cells[--m_size]);
+        }
+    };
+    thread_local mpz_cell_cache g_mpz_cell_cache;
+}
+#endif
+
 template<bool SYNCH>
 mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     SASSERT(capacity >= m_init_cell_capacity);
@@ -195,7 +237,11 @@ mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
 #else
     if (SYNCH) {
-        cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
+        mpz_cell_cache & cache = g_mpz_cell_cache;
+        if (cache.m_size > 0 && cache.m_capacity == capacity)
+            cell = reinterpret_cast<mpz_cell*>(cache.m_cells[--cache.m_size]);
+        else
+            cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
     }
     else {
         cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
@@ -214,7 +260,14 @@ void mpz_manager<SYNCH>::deallocate(bool is_heap, mpz_cell * ptr) {
         m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
 #else
         if (SYNCH) {
-            memory::deallocate(ptr);
+            mpz_cell_cache & cache = g_mpz_cell_cache;
+            if (ptr->m_capacity == m_init_cell_capacity && cache.m_size < mpz_cell_cache::max_size) {
+                cache.m_capacity = m_init_cell_capacity;
+                cache.m_cells[cache.m_size++] = ptr;
+            }
+            else {
+                memory::deallocate(ptr);
+            }
         }
         else {
             m_allocator.deallocate(cell_size(ptr->m_capacity), ptr);        
@@ -687,10 +740,60 @@ void mpz_manager<SYNCH>::abs(mpz & a) {
 
 
 // TBD: replace use of 'tmp' by 'c'.
+#ifdef _MPZ_INT128
+template<bool SYNCH>
+bool mpz_manager<SYNCH>::get_u128(mpz const & a, int & sign, u128 & v) const {
+    if (is_small(a)) {
+        sign = a.m_val < 0 ? -1 : 1;
+        v = a.m_val < 0 ? static_cast<u128>(-static_cast<int64_t>(a.m_val)) : static_cast<u128>(a.m_val);
+        return true;
+    }
+    unsigned sz = a.m_ptr->m_size;
+    if (sz * sizeof(digit_t) > sizeof(u128))
+        return false;
+    sign = a.m_val;
+    v = 0;
+    for (unsigned i = sz; i-- > 0; ) 
+        v = (v << (8 * sizeof(digit_t))) | a.m_ptr->m_digits[i];
+    return true;
+}
+
+template<bool SYNCH>
+void mpz_manager<SYNCH>::set_u128(mpz & a, int sign, u128 v) {
+    if (v <= static_cast<u128>(INT_MAX)) {
+        set(a, sign < 0 ? -static_cast<int>(v) : static_cast<int>(v));
+        return;
+    }
+    digit_t ds[sizeof(u128) / sizeof(digit_t)];
+    unsigned sz = 0;
+    for (; v != 0; v >>= (8 * sizeof(digit_t))) 
+        ds[sz++] = static_cast<digit_t>(v);
+    set_digits(a, sz, ds);
+    a.m_val = sign;
+}
+#endif
+
 #ifndef _MP_GMP
 template<bool SYNCH>
 template<bool SUB>
 void mpz_manager<SYNCH>::big_add_sub(mpz const & a, mpz const & b, mpz & c) {
+#ifdef _MPZ_INT128
+    {
+        int sa, sb;
+        u128 va, vb;
+        static const u128 max_val = static_cast<u128>(1) << 126;
+        if (get_u128(a, sa, va) && get_u128(b, sb, vb) && va < max_val && vb < max_val) {
+            __int128 r = (sa < 0 ? -static_cast<__int128>(va) : static_cast<__int128>(va));
+            __int128 s = (sb < 0 ? -static_cast<__int128>(vb) : static_cast<__int128>(vb));
+            r = SUB ? r - s : r + s;
+            if (r < 0)
+                set_u128(c, -1, static_cast<u128>(-r));
+            else
+                set_u128(c, 1, static_cast<u128>(r));
+            return;
+        }
+    }
+#endif
     sign_cell ca(*this, a), cb(*this, b);
     int sign_b = cb.sign();
     mpz_stack tmp;
@@ -772,6 +875,16 @@ void mpz_manager<SYNCH>::big_sub(mpz const & a, mpz const & b, mpz & c) {
 
 template<bool SYNCH>
 void mpz_manager<SYNCH>::big_mul(mpz const & a, mpz const & b, mpz & c) {
+#ifdef _MPZ_INT128
+    {
+        int sa, sb;
+        u128 va, vb;
+        if (get_u128(a, sa, va) && get_u128(b, sb, vb) && (va >> 64) == 0 && (vb >> 64) == 0) {
+            set_u128(c, sa == sb ? 1 : -1, va * vb);
+            return;
+        }
+    }
+#endif
 #ifndef _MP_GMP
     // TBD replace tmp by c.
     mpz_stack tmp;
@@ -819,6 +932,20 @@ void mpz_manager<SYNCH>::quot_rem_core(mpz const & a, mpz const & b, mpz & q, mp
       -26 / -7 = +3, remainder is -5 
     */
 
+#ifdef _MPZ_INT128
+    {
+        int sa, sb;
+        u128 va, vb;
+        if (get_u128(a, sa, va) && get_u128(b, sb, vb)) {
+            SASSERT(vb != 0);
+            if (MODE == QUOT_ONLY || MODE == QUOT_AND_REM)
+                set_u128(q, sa == sb ? 1 : -1, va / vb);
+            if (MODE == REM_ONLY || MODE == QUOT_AND_REM)
+                set_u128(r, sa, va % vb);
+            return;
+        }
+    }
+#endif
     mpz_stack q1, r1;
     sign_cell ca(*this, a), cb(*this, b);
     if (cb.cell()->m_size > ca.cell()->m_size) {
@@ -904,6 +1031,16 @@ void mpz_manager<SYNCH>::gcd(mpz const & a, mpz const & b, mpz & c) {
             abs(c);
             return;
         }
+#ifdef _MPZ_INT128
+        {
+            int sa, sb;
+            u128 va, vb;
+            if (get_u128(a, sa, va) && get_u128(b, sb, vb)) {
+                set_u128(c, 1, u128_gcd(va, vb));
+                return;
+            }
+        }
+#endif
 #ifdef BINARY_GCD
         // Binary GCD for big numbers
         // - It doesn't use division
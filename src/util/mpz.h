@@ -30,6 +30,11 @@ Revision History:
 unsigned u_gcd(unsigned u, unsigned v);
 uint64_t u64_gcd(uint64_t u, uint64_t v);
 
+#if !defined(_MP_GMP) && defined(__SIZEOF_INT128__)
+#define _MPZ_INT128
+unsigned __int128 u128_gcd(unsigned __int128 u, unsigned __int128 v);
+#endif
+
 #ifdef _MP_GMP
 typedef unsigned digit_t;
 #endif
@@ -406,6 +411,15 @@ public:
     
     void del(mpz & a) { del(this, a); }
 
+#ifdef _MPZ_INT128
+    typedef unsigned __int128 u128;
+    // Fast path for numbers whose absolute value fits in 128 bits.
+    // Store the sign and absolute value of a in sign and v, return false if a does not fit.
+    bool get_u128(mpz const & a, int & sign, u128 & v) const;
+    // Set a to sign * v.
+    void set_u128(mpz & a, int sign, u128 v);
+#endif
+
     static void del(mpz_manager* m, mpz & a);
     
     void add(mpz const & a, mpz const & b, mpz & c);
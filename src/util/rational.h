@@ -66,6 +66,11 @@ public:
     
     mpq const & to_mpq() const { return m_val; }
 
+    /**
+       \brief Set this to n/d without normalizing; n and d must be coprime and d > 0.
+    */
+    void set_normalized(int64_t n, uint64_t d) { m().set_normalized(m_val, n, d); }
+
     unsigned bitsize() const { return m().bitsize(m_val); }
 
     unsigned storage_size() const { return m().storage_size(m_val); }
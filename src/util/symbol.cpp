@@ -20,6 +20,7 @@ Revision History:
 #include "util/symbol.h"
 #include "util/mutex.h"
 #include "util/str_hashtable.h"
+#include "util/vector.h"
 #include "util/region.h"
 #include "util/string_buffer.h"
 #include <cstring>
@@ -34,42 +35,109 @@ const symbol symbol::null;
 
 /**
    \brief Symbol table manager. It stores the symbol strings created at runtime.
+
+   The strings are kept in an open addressing hash table of string pointers.
+   Lookups do not take the lock: they probe the current table, and the slots
+   of a table are only ever filled, never cleared. Insertions take the lock
+   and re-probe before adding the string. When the table grows, the new table is
+   published after it is filled and the old one is retired, but kept alive
+   until the symbol table is destroyed, since concurrent readers may still probe it.
 */
 class internal_symbol_table {
-    region        m_region; //!< Region used to store symbol strings.
-    str_hashtable m_table;  //!< Table of created symbol strings.
+    struct table {
+        unsigned               m_capacity; //!< power of two
+        atomic<char const*> *  m_slots;
+    };
+    region            m_region; //!< Region used to store symbol strings.
+    atomic<table*>    m_table;  //!< Table of created symbol strings.
+    ptr_vector<table> m_retired;
+    unsigned          m_size;
     DECLARE_MUTEX(lock);
+
+    static table * mk_table(unsigned capacity) {
+        table * t = alloc(table);
+        t->m_capacity = capacity;
+        t->m_slots = static_cast<atomic<char const*>*>(memory::allocate(sizeof(atomic<char const*>) * capacity));
+        for (unsigned i = 0; i < capacity; ++i)
+            new (t->m_slots + i) atomic<char const*>(nullptr);
+        return t;
+    }
+
+    static void del_table(table * t) {
+        memory::deallocate(t->m_slots);
+        dealloc(t);
+    }
+
+    static unsigned get_hash(char const * s) {
+        return static_cast<unsigned>(reinterpret_cast<size_t const *>(s)[-1]);
+    }
+
+    static char const * find(table const * t, char const * d, unsigned h) {
+        unsigned mask = t->m_capacity - 1;
+        for (unsigned i = h & mask; ; i = (i + 1) & mask) {
+            char const * s = t->m_slots[i];
+            if (!s)
+                return nullptr;
+            if (get_hash(s) == h && strcmp(s, d) == 0)
+                return s;
+        }
+    }
+
+    static void insert(table * t, char const * s) {
+        unsigned mask = t->m_capacity - 1;
+        unsigned i = get_hash(s) & mask;
+        while (t->m_slots[i] != nullptr)
+            i = (i + 1) & mask;
+        t->m_slots[i] = s;
+    }
+
+    table * grow(table * t) {
+        table * new_t = mk_table(2 * t->m_capacity);
+        for (unsigned i = 0; i < t->m_capacity; ++i) {
+            char const * s = t->m_slots[i];
+            if (s)
+                insert(new_t, s);
+        }
+        m_table = new_t;
+        m_retired.push_back(t);
+        return new_t;
+    }
     
 public:
 
-    internal_symbol_table() {
+    internal_symbol_table(): m_table(mk_table(64)), m_size(0) {
         ALLOC_MUTEX(lock);
     }
 
     ~internal_symbol_table() {
+        for (table * t : m_retired)
+            del_table(t);
+        del_table(m_table);
         DEALLOC_MUTEX(lock);
     }
 
-    char const * get_str(char const * d) {
-        const char * result;
+    /**
+       \brief return the interned copy of d, h is string_hash(d, len, 17) and len is strlen(d).
+    */
+    char const * get_str(char const * d, unsigned len, unsigned h) {
+        char const * result = find(m_table, d, h);
+        if (result)
+            return result;
         lock_guard _lock(*lock);
-        str_hashtable::entry * e;
-        if (m_table.insert_if_not_there_core(d, e)) {
-            // new entry
-            size_t l   = strlen(d);
-            // store the hash-code before the string
-            size_t * mem = static_cast<size_t*>(m_region.allocate(l + 1 + sizeof(size_t)));
-            *mem = e->get_hash();
-            mem++;
-            result = reinterpret_cast<const char*>(mem);
-            memcpy(mem, d, l+1);
-            // update the entry with the new ptr.
-            e->set_data(result);
-        }
-        else {
-            result = e->get_data();
-        }
-        SASSERT(m_table.contains(result));
+        table * t = m_table;
+        result = find(t, d, h);
+        if (result)
+            return result;
+        if (2 * (m_size + 1) > t->m_capacity)
+            t = grow(t);
+        // store the hash-code before the string
+        size_t * mem = static_cast<size_t*>(m_region.allocate(len + 1 + sizeof(size_t)));
+        *mem = h;
+        mem++;
+        memcpy(mem, d, len + 1);
+        result = reinterpret_cast<const char*>(mem);
+        insert(t, result);
+        m_size++;
         return result;
     }
 };
@@ -91,8 +159,11 @@ struct internal_symbol_tables {
     }
 
     char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
+        unsigned len = static_cast<unsigned>(strlen(d));
+        unsigned h = string_hash(d, len, 17);
+        // the low bits of h select the slot inside a table, use the high bits for the table.
+        auto* table = tables[(h >> 16) % sz];
+        return table->get_str(d, len, h);
     }
 };
 
@@ -104,7 +175,7 @@ void initialize_symbols() {
 #ifdef SINGLE_THREAD
         unsigned num_tables = 1;
 #else
-        unsigned num_tables = 2 * std::min((unsigned) std::thread::hardware_concurrency(), 64u);
+        unsigned num_tables = 2 * std::max(1u, std::min((unsigned) std::thread::hardware_concurrency(), 64u));
 #endif
         g_symbol_tables = alloc(internal_symbol_tables, num_tables);
         